@@ -24,6 +24,8 @@
 #define EFL_BETA_API_SUPPORT 1
 #endif
 
+#include <stdio.h>
+
 #include <Eina.h>
 #include <Evas.h>
 #include <Ecore.h>
@@ -32,8 +34,234 @@
 #include <Echart.h>
 #include <echart_data.h>
 #include <echart_chart.h>
-#include <echart_line.h>
-#include <echart_vbar.h>
+#include <echart_trace.h>
+
+#include "echart_render.h"
+#include "echart_batch.h"
+
+typedef struct
+{
+    Echart_Type type;
+    Echart_Backend backend;
+    int w;
+    int h;
+    Eina_List *outputs;
+    const char *socket_name;
+    const char *trace;
+    unsigned int jobs;
+    Eina_Bool batch;
+    Eina_Bool help;
+} Echart_Options;
+
+static void
+_echart_usage(const char *prog)
+{
+    printf("Usage: %s [OPTION]...\n", prog);
+    printf("Display a chart in a window, or render it in files.\n\n");
+    printf("  -t, --type TYPE        chart type: line, vbar, scatter or candle\n");
+    printf("                         (default: line)\n");
+    printf("  -b, --backend BACKEND  rendering backend: vg or raster (default: vg)\n");
+    printf("  -s, --size WxH         size of the chart (default: 800x600)\n");
+    printf("  -o, --output FILE      render without window in FILE (png or ppm),\n");
+    printf("                         can be repeated\n");
+    printf("      --batch            render the charts described on stdin, one per\n");
+    printf("                         line: SOURCE TYPE WxH OUTPUT, SOURCE being\n");
+    printf("                         'sample' or a CSV file\n");
+    printf("      --socket NAME      like --batch, reading the charts from the\n");
+    printf("                         clients of the local socket NAME\n");
+    printf("  -j, --jobs N           number of data loaded at the same time in\n");
+    printf("                         batch mode (default: number of CPU)\n");
+    printf("      --trace FILE       write the trace events in FILE, in the Chrome\n");
+    printf("                         trace event format (library built with the\n");
+    printf("                         trace option)\n");
+    printf("  -h, --help             display this help and exit\n");
+}
+
+static Eina_Bool
+_echart_options_parse(int argc, char **argv, Echart_Options *opt)
+{
+    int i;
+
+    opt->type = ECHART_TYPE_LINE;
+    opt->backend = ECHART_BACKEND_VG;
+    opt->w = 800;
+    opt->h = 600;
+    opt->outputs = NULL;
+    opt->socket_name = NULL;
+    opt->trace = NULL;
+    opt->jobs = eina_cpu_count();
+    opt->batch = EINA_FALSE;
+    opt->help = EINA_FALSE;
+
+    for (i = 1; i < argc; i++)
+    {
+        const char *arg;
+
+        arg = argv[i];
+        if (!strcmp(arg, "-h") || !strcmp(arg, "--help"))
+        {
+            opt->help = EINA_TRUE;
+            return EINA_TRUE;
+        }
+
+        if (!strcmp(arg, "--batch"))
+        {
+            opt->batch = EINA_TRUE;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            goto err_;
+
+        if (!strcmp(arg, "-t") || !strcmp(arg, "--type"))
+        {
+            i++;
+            if (!echart_render_type_get(argv[i], &opt->type))
+                goto err_;
+        }
+        else if (!strcmp(arg, "-b") || !strcmp(arg, "--backend"))
+        {
+            i++;
+            if (!strcmp(argv[i], "vg"))
+                opt->backend = ECHART_BACKEND_VG;
+            else if (!strcmp(argv[i], "raster"))
+                opt->backend = ECHART_BACKEND_RASTER;
+            else
+                goto err_;
+        }
+        else if (!strcmp(arg, "-s") || !strcmp(arg, "--size"))
+        {
+            i++;
+            if ((sscanf(argv[i], "%dx%d", &opt->w, &opt->h) != 2) ||
+                (opt->w <= 0) || (opt->h <= 0))
+                goto err_;
+        }
+        else if (!strcmp(arg, "-o") || !strcmp(arg, "--output"))
+        {
+            i++;
+            opt->outputs = eina_list_append(opt->outputs, argv[i]);
+        }
+        else if (!strcmp(arg, "--socket"))
+        {
+            i++;
+            opt->socket_name = argv[i];
+            opt->batch = EINA_TRUE;
+        }
+        else if (!strcmp(arg, "--trace"))
+        {
+            i++;
+            opt->trace = argv[i];
+        }
+        else if (!strcmp(arg, "-j") || !strcmp(arg, "--jobs"))
+        {
+            int jobs;
+
+            i++;
+            if ((sscanf(argv[i], "%d", &jobs) != 1) || (jobs <= 0))
+                goto err_;
+            opt->jobs = jobs;
+        }
+        else
+            goto err_;
+    }
+
+    return EINA_TRUE;
+
+  err_:
+    fprintf(stderr, "%s: invalid argument '%s'\n", argv[0], argv[i]);
+    fprintf(stderr, "Try '%s --help' for more information.\n", argv[0]);
+    eina_list_free(opt->outputs);
+    opt->outputs = NULL;
+
+    return EINA_FALSE;
+}
+
+static Echart_Chart *
+_echart_chart_sample_new(const Echart_Options *opt)
+{
+    Echart_Chart *chart;
+
+    chart = echart_chart_new(opt->w, opt->h);
+    if (!chart)
+        return NULL;
+
+    echart_chart_title_set(chart, "Company Performance");
+    echart_chart_data_set(chart, echart_render_data_sample_new());
+    echart_chart_background_color_set(chart, 0xffffffff);
+    echart_chart_backend_set(chart, opt->backend);
+
+    return chart;
+}
+
+/*
+ * Render the charts in a buffer canvas, without window and without
+ * running the main loop. The canvas and the image used to save the
+ * files are created once for all the charts.
+ */
+static int
+_echart_headless_run(const Echart_Options *opt)
+{
+    Echart_Render er;
+    Eina_List *l;
+    const char *file;
+    double t_start;
+    int ret;
+
+    if (!echart_render_init(&er))
+        return -1;
+
+    ret = 0;
+    t_start = ecore_time_get();
+    EINA_LIST_FOREACH(opt->outputs, l, file)
+    {
+        Echart_Chart *chart;
+        Echart_Render_Timing timing;
+
+        chart = _echart_chart_sample_new(opt);
+        if (!chart)
+        {
+            ret = -1;
+            continue;
+        }
+
+        if (!echart_render_file(&er, opt->type, chart, file, &timing))
+        {
+            fprintf(stderr, "Could not save the chart in %s.\n", file);
+            ret = -1;
+        }
+
+        echart_chart_free(chart);
+
+        printf("%s: render %.3f ms, save %.3f ms\n",
+               file, timing.render * 1000.0, timing.save * 1000.0);
+    }
+    printf("%u charts in %.3f s\n",
+           eina_list_count(opt->outputs), ecore_time_get() - t_start);
+
+    echart_render_shutdown(&er);
+
+    return ret;
+}
+
+/*
+ * Render the charts described on stdin, or sent to a local socket, on a
+ * canvas created once, until the end of the input.
+ */
+static int
+_echart_batch_run(const Echart_Options *opt)
+{
+    Echart_Render er;
+    int ret;
+
+    if (!echart_render_init(&er))
+        return -1;
+
+    ret = echart_batch_run(&er, opt->backend, opt->jobs, opt->socket_name);
+
+    echart_render_shutdown(&er);
+
+    return ret;
+}
 
 static void
 _echart_delete_cb(Ecore_Evas *ee EINA_UNUSED)
@@ -41,85 +269,96 @@ _echart_delete_cb(Ecore_Evas *ee EINA_UNUSED)
     ecore_main_loop_quit();
 }
 
-int main(void)
+/* the chart follows the size of the window */
+static void
+_echart_resize_cb(Ecore_Evas *ee)
 {
-    Ecore_Evas *ee;
-    Evas *evas;
     Evas_Object *o;
-    Echart_Chart *chart;
-    Echart_Data *d;
-    Echart_Serie *s;
     int w;
     int h;
 
-    if (!ecore_evas_init())
-        return -1;
+    o = ecore_evas_data_get(ee, "chart");
+    if (!o)
+        return;
 
-    if (!echart_init())
-        goto shutdown_ecore_evas;
+    ecore_evas_geometry_get(ee, NULL, NULL, &w, &h);
+    evas_object_resize(o, w, h);
+}
+
+static int
+_echart_window_run(const Echart_Options *opt)
+{
+    Ecore_Evas *ee;
+    Evas *evas;
+    Evas_Object *o;
+    Echart_Chart *chart;
 
     ee = ecore_evas_new(NULL, 0, 0, 1, 1, NULL);
     if (!ee)
-        goto shutdown_echart;
+        return -1;
 
     ecore_evas_callback_delete_request_set(ee, _echart_delete_cb);
     evas = ecore_evas_get(ee);
 
-    d = echart_data_new();
-    echart_data_title_set(d, "Company Performance");
-
-    s = echart_serie_new();
-    echart_serie_title_set(s, "Year");
-    echart_serie_value_push(s, 2004);
-    echart_serie_value_push(s, 2005);
-    echart_serie_value_push(s, 2006);
-    echart_serie_value_push(s, 2007);
-    echart_data_absciss_set(d, s);
-
-    s = echart_serie_new();
-    echart_serie_title_set(s, "Sales");
-    echart_serie_value_push(s, 1000);
-    echart_serie_value_push(s, 1170);
-    echart_serie_value_push(s, 660);
-    echart_serie_value_push(s, 1030);
-    echart_data_serie_append(d, s);
-
-    s = echart_serie_new();
-    echart_serie_title_set(s, "Expenses");
-    echart_serie_value_push(s, 400);
-    echart_serie_value_push(s, 460);
-    echart_serie_value_push(s, 1120);
-    echart_serie_value_push(s, 540);
-    echart_data_serie_append(d, s);
-
-    echart_data_ymin_set(d, 0);
-    echart_data_area_set(d, EINA_TRUE);
-
-    chart = echart_chart_new(800, 600);
-    echart_chart_title_set(chart, "Company Performance");
-    echart_chart_data_set(chart, d);
-    echart_chart_size_get(chart, &w, &h);
-    echart_chart_background_color_set(chart, 0xffffffff);
+    chart = _echart_chart_sample_new(opt);
+    if (!chart)
+    {
+        ecore_evas_free(ee);
+        return -1;
+    }
 
-#if 1
-    o = echart_line_object_add(evas);
-    echart_line_object_chart_set(o, chart);
-#else
-    o = echart_vbar_object_add(evas);
-    echart_vbar_object_chart_set(o, chart);
-#endif
+    o = echart_render_object_add(evas, opt->type, chart);
     evas_object_show(o);
+    ecore_evas_data_set(ee, "chart", o);
+    ecore_evas_callback_resize_set(ee, _echart_resize_cb);
 
-    ecore_evas_resize(ee, w, h);
+    ecore_evas_resize(ee, opt->w, opt->h);
     ecore_evas_show(ee);
 
     ecore_main_loop_begin();
 
+    ecore_evas_data_set(ee, "chart", NULL);
+    evas_object_del(o);
     echart_chart_free(chart);
+    ecore_evas_free(ee);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    Echart_Options opt;
+    int ret;
+
+    if (!ecore_evas_init())
+        return -1;
+
+    if (!echart_init())
+        goto shutdown_ecore_evas;
+
+    if (!_echart_options_parse(argc, argv, &opt))
+        goto shutdown_echart;
+
+    if (opt.help)
+    {
+        _echart_usage(argv[0]);
+        ret = 0;
+    }
+    else if (opt.batch)
+        ret = _echart_batch_run(&opt);
+    else if (opt.outputs)
+        ret = _echart_headless_run(&opt);
+    else
+        ret = _echart_window_run(&opt);
+
+    if (opt.trace && !echart_trace_dump(opt.trace))
+        fprintf(stderr, "%s: could not write the trace in %s\n", argv[0], opt.trace);
+
+    eina_list_free(opt.outputs);
     echart_shutdown();
     ecore_evas_shutdown();
 
-    return 0;
+    return ret;
 
   shutdown_echart:
     echart_shutdown();
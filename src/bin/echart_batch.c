@@ -0,0 +1,537 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <stdio.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Evas.h>
+#include <Ecore.h>
+#include <Ecore_Evas.h>
+#include <Ecore_Con.h>
+
+#include <Echart.h>
+#include <echart_data.h>
+#include <echart_chart.h>
+
+#include "echart_render.h"
+#include "echart_batch.h"
+
+/*
+ * Batch mode: the specs are read, one per line, from stdin or from the
+ * clients of a local socket:
+ *
+ *   SOURCE TYPE WxH OUTPUT
+ *
+ * The data are loaded in threads, at most 'jobs' at the same time, but
+ * as Evas is not thread safe, the charts are rendered one after another
+ * in the main loop, on the same buffer canvas.
+ */
+
+typedef struct _Echart_Batch Echart_Batch;
+
+typedef struct
+{
+    Echart_Batch *batch;
+    Ecore_Con_Client *client; /* NULL for stdin */
+    unsigned int id;
+    char *source;
+    char *output;
+    Echart_Type type;
+    int w;
+    int h;
+    Echart_Data *data;
+    double t_start;
+    double t_load;
+    Eina_Bool detached : 1; /* the client has gone */
+} Echart_Batch_Request;
+
+struct _Echart_Batch
+{
+    Echart_Render *er;
+    Echart_Backend backend;
+    unsigned int jobs;
+    unsigned int running;
+    unsigned int id;
+    Eina_List *pending;
+    Eina_List *loading;
+    Eina_Strbuf *in;
+    Ecore_Fd_Handler *fdh;
+    Ecore_Con_Server *server;
+    Eina_List *handlers;
+    int ret;
+};
+
+/* a failed request makes the exit status non zero */
+static void
+_echart_batch_reply(Echart_Batch *batch,
+                    Ecore_Con_Client *client,
+                    Eina_Bool success,
+                    const char *str)
+{
+    if (!success)
+        batch->ret = -1;
+
+    if (client)
+        ecore_con_client_send(client, str, strlen(str));
+    else
+    {
+        fputs(str, stdout);
+        fflush(stdout);
+    }
+}
+
+static void
+_echart_batch_request_free(Echart_Batch_Request *req)
+{
+    echart_data_free(req->data);
+    free(req->source);
+    free(req->output);
+    free(req);
+}
+
+static void
+_echart_batch_quit_check(Echart_Batch *batch)
+{
+    if (!batch->fdh && !batch->server && !batch->pending && !batch->running)
+        ecore_main_loop_quit();
+}
+
+static void _echart_batch_dispatch(Echart_Batch *batch);
+
+static void
+_echart_batch_load_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+    Echart_Batch_Request *req;
+
+    req = data;
+    req->data = echart_render_data_load(req->source);
+}
+
+static void
+_echart_batch_load_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+    Echart_Batch_Request *req;
+    Echart_Batch *batch;
+    Echart_Render_Timing timing;
+    Echart_Chart *chart;
+    char buf[PATH_MAX + 128];
+    Eina_Bool ret;
+
+    req = data;
+    batch = req->batch;
+    batch->running--;
+    batch->loading = eina_list_remove(batch->loading, req);
+    req->t_load = ecore_time_get() - req->t_start;
+
+    if (req->detached)
+        goto end;
+
+    if (!req->data)
+    {
+        snprintf(buf, sizeof(buf), "%u %s: error: can not load %s\n",
+                 req->id, req->output, req->source);
+        _echart_batch_reply(batch, req->client, EINA_FALSE, buf);
+        goto end;
+    }
+
+    chart = echart_chart_new(req->w, req->h);
+    if (!chart)
+    {
+        snprintf(buf, sizeof(buf), "%u %s: error: can not create chart\n",
+                 req->id, req->output);
+        _echart_batch_reply(batch, req->client, EINA_FALSE, buf);
+        goto end;
+    }
+
+    echart_chart_data_set(chart, req->data);
+    req->data = NULL;
+    echart_chart_background_color_set(chart, 0xffffffff);
+    echart_chart_backend_set(chart, batch->backend);
+
+    ret = echart_render_file(batch->er, req->type, chart, req->output, &timing);
+    if (ret)
+        snprintf(buf, sizeof(buf),
+                 "%u %s: load %.3f ms, render %.3f ms, save %.3f ms, total %.3f ms\n",
+                 req->id, req->output,
+                 req->t_load * 1000.0,
+                 timing.render * 1000.0,
+                 timing.save * 1000.0,
+                 (ecore_time_get() - req->t_start) * 1000.0);
+    else
+        snprintf(buf, sizeof(buf), "%u %s: error: can not save chart\n",
+                 req->id, req->output);
+    _echart_batch_reply(batch, req->client, ret, buf);
+
+    echart_chart_free(chart);
+
+  end:
+    _echart_batch_request_free(req);
+    _echart_batch_dispatch(batch);
+    _echart_batch_quit_check(batch);
+}
+
+static void
+_echart_batch_load_cancel_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+    Echart_Batch_Request *req;
+    Echart_Batch *batch;
+
+    req = data;
+    batch = req->batch;
+    batch->running--;
+    batch->loading = eina_list_remove(batch->loading, req);
+    _echart_batch_request_free(req);
+    _echart_batch_dispatch(batch);
+    _echart_batch_quit_check(batch);
+}
+
+static void
+_echart_batch_dispatch(Echart_Batch *batch)
+{
+    while (batch->pending && (batch->running < batch->jobs))
+    {
+        Echart_Batch_Request *req;
+
+        req = eina_list_data_get(batch->pending);
+        batch->pending = eina_list_remove_list(batch->pending, batch->pending);
+        batch->loading = eina_list_append(batch->loading, req);
+        batch->running++;
+        ecore_thread_run(_echart_batch_load_cb,
+                         _echart_batch_load_end_cb,
+                         _echart_batch_load_cancel_cb,
+                         req);
+    }
+}
+
+/* next token of s, separated by spaces, or NULL */
+static char *
+_echart_batch_token(char **s)
+{
+    char *p;
+    char *tok;
+
+    p = *s;
+    while ((*p == ' ') || (*p == '\t'))
+        p++;
+    if (!*p)
+        return NULL;
+
+    tok = p;
+    while (*p && (*p != ' ') && (*p != '\t'))
+        p++;
+    if (*p)
+        *p++ = '\0';
+    *s = p;
+
+    return tok;
+}
+
+static void
+_echart_batch_line_process(Echart_Batch *batch,
+                           Ecore_Con_Client *client,
+                           char *line)
+{
+    Echart_Batch_Request *req;
+    char *source;
+    char *type;
+    char *size;
+    char *output;
+    Echart_Type t;
+    int w;
+    int h;
+
+    while ((*line == ' ') || (*line == '\t'))
+        line++;
+    if ((*line == '\0') || (*line == '#'))
+        return;
+
+    source = _echart_batch_token(&line);
+    type = _echart_batch_token(&line);
+    size = _echart_batch_token(&line);
+    output = _echart_batch_token(&line);
+    if (!output || _echart_batch_token(&line) ||
+        !echart_render_type_get(type, &t) ||
+        (sscanf(size, "%dx%d", &w, &h) != 2) || (w <= 0) || (h <= 0))
+    {
+        _echart_batch_reply(batch, client, EINA_FALSE,
+                            "error: invalid spec, expected: SOURCE TYPE WxH OUTPUT\n");
+        return;
+    }
+
+    req = (Echart_Batch_Request *)calloc(1, sizeof(Echart_Batch_Request));
+    if (!req)
+        return;
+
+    req->batch = batch;
+    req->client = client;
+    req->id = ++batch->id;
+    req->source = strdup(source);
+    req->output = strdup(output);
+    req->type = t;
+    req->w = w;
+    req->h = h;
+    req->t_start = ecore_time_get();
+    if (!req->source || !req->output)
+    {
+        _echart_batch_request_free(req);
+        return;
+    }
+
+    batch->pending = eina_list_append(batch->pending, req);
+}
+
+/* process the complete lines of buf and keep the remaining bytes */
+static void
+_echart_batch_buffer_process(Echart_Batch *batch,
+                             Ecore_Con_Client *client,
+                             Eina_Strbuf *buf,
+                             Eina_Bool flush)
+{
+    char *str;
+    char *line;
+    char *next;
+    size_t len;
+
+    str = eina_strbuf_string_steal(buf);
+    len = strlen(str);
+    for (line = str; (next = strchr(line, '\n')); line = next)
+    {
+        *next++ = '\0';
+        if ((next - 2 >= line) && (next[-2] == '\r'))
+            next[-2] = '\0';
+        _echart_batch_line_process(batch, client, line);
+    }
+
+    if (flush)
+        _echart_batch_line_process(batch, client, line);
+    else
+        eina_strbuf_append_length(buf, line, len - (line - str));
+    free(str);
+
+    _echart_batch_dispatch(batch);
+}
+
+static Eina_Bool
+_echart_batch_stdin_cb(void *data, Ecore_Fd_Handler *fdh)
+{
+    Echart_Batch *batch;
+    char buf[4096];
+    ssize_t n;
+
+    batch = data;
+    n = read(ecore_main_fd_handler_fd_get(fdh), buf, sizeof(buf));
+    if (n > 0)
+    {
+        eina_strbuf_append_length(batch->in, buf, n);
+        _echart_batch_buffer_process(batch, NULL, batch->in, EINA_FALSE);
+        return ECORE_CALLBACK_RENEW;
+    }
+
+    /* end of file, or error */
+    _echart_batch_buffer_process(batch, NULL, batch->in, EINA_TRUE);
+    batch->fdh = NULL;
+    _echart_batch_quit_check(batch);
+
+    return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_echart_batch_client_add_cb(void *data EINA_UNUSED,
+                            int type EINA_UNUSED,
+                            void *event)
+{
+    Ecore_Con_Event_Client_Add *ev;
+
+    ev = event;
+    ecore_con_client_data_set(ev->client, eina_strbuf_new());
+
+    return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_echart_batch_client_data_cb(void *data, int type EINA_UNUSED, void *event)
+{
+    Ecore_Con_Event_Client_Data *ev;
+    Eina_Strbuf *buf;
+
+    ev = event;
+    buf = ecore_con_client_data_get(ev->client);
+    if (!buf)
+        return ECORE_CALLBACK_RENEW;
+
+    eina_strbuf_append_length(buf, ev->data, ev->size);
+    _echart_batch_buffer_process(data, ev->client, buf, EINA_FALSE);
+
+    return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_echart_batch_client_del_cb(void *data, int type EINA_UNUSED, void *event)
+{
+    Ecore_Con_Event_Client_Del *ev;
+    Echart_Batch *batch;
+    Echart_Batch_Request *req;
+    Eina_List *l;
+    Eina_List *l_next;
+
+    ev = event;
+    batch = data;
+
+    /* the pending requests of the client are dropped, the loading ones detached */
+    EINA_LIST_FOREACH_SAFE(batch->pending, l, l_next, req)
+    {
+        if (req->client == ev->client)
+        {
+            batch->pending = eina_list_remove_list(batch->pending, l);
+            _echart_batch_request_free(req);
+        }
+    }
+    EINA_LIST_FOREACH(batch->loading, l, req)
+    {
+        if (req->client == ev->client)
+        {
+            req->client = NULL;
+            req->detached = EINA_TRUE;
+        }
+    }
+
+    eina_strbuf_free(ecore_con_client_data_get(ev->client));
+    ecore_con_client_data_set(ev->client, NULL);
+
+    return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_echart_batch_signal_exit_cb(void *data,
+                             int type EINA_UNUSED,
+                             void *event EINA_UNUSED)
+{
+    Echart_Batch *batch;
+    Echart_Batch_Request *req;
+
+    batch = data;
+
+    /* stop reading, drop the pending specs and finish the loading ones */
+    if (batch->fdh)
+    {
+        ecore_main_fd_handler_del(batch->fdh);
+        batch->fdh = NULL;
+    }
+    if (batch->server)
+    {
+        ecore_con_server_del(batch->server);
+        batch->server = NULL;
+    }
+    EINA_LIST_FREE(batch->pending, req)
+        _echart_batch_request_free(req);
+
+    _echart_batch_quit_check(batch);
+
+    return ECORE_CALLBACK_RENEW;
+}
+
+int
+echart_batch_run(Echart_Render *er,
+                 Echart_Backend backend,
+                 unsigned int jobs,
+                 const char *socket_name)
+{
+    Echart_Batch batch;
+    Ecore_Event_Handler *h;
+
+    memset(&batch, 0, sizeof(Echart_Batch));
+    batch.er = er;
+    batch.backend = backend;
+    batch.jobs = jobs ? jobs : 1;
+
+    batch.in = eina_strbuf_new();
+    if (!batch.in)
+        return -1;
+
+    if (socket_name)
+    {
+        if (!ecore_con_init())
+            goto free_in;
+
+        batch.server = ecore_con_server_add(ECORE_CON_LOCAL_USER,
+                                            socket_name, 0, &batch);
+        if (!batch.server)
+        {
+            fprintf(stderr, "Could not create the socket %s.\n", socket_name);
+            goto shutdown_ecore_con;
+        }
+
+        batch.handlers = eina_list_append(batch.handlers,
+                                          ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD,
+                                                                  _echart_batch_client_add_cb,
+                                                                  &batch));
+        batch.handlers = eina_list_append(batch.handlers,
+                                          ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA,
+                                                                  _echart_batch_client_data_cb,
+                                                                  &batch));
+        batch.handlers = eina_list_append(batch.handlers,
+                                          ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DEL,
+                                                                  _echart_batch_client_del_cb,
+                                                                  &batch));
+    }
+    else
+    {
+        batch.fdh = ecore_main_fd_handler_add(STDIN_FILENO, ECORE_FD_READ,
+                                              _echart_batch_stdin_cb, &batch,
+                                              NULL, NULL);
+        if (!batch.fdh)
+            goto free_in;
+    }
+
+    batch.handlers = eina_list_append(batch.handlers,
+                                      ecore_event_handler_add(ECORE_EVENT_SIGNAL_EXIT,
+                                                              _echart_batch_signal_exit_cb,
+                                                              &batch));
+
+    ecore_main_loop_begin();
+
+    EINA_LIST_FREE(batch.handlers, h)
+        ecore_event_handler_del(h);
+
+    if (socket_name)
+    {
+        if (batch.server)
+            ecore_con_server_del(batch.server);
+        ecore_con_shutdown();
+    }
+    eina_strbuf_free(batch.in);
+
+    return batch.ret;
+
+  shutdown_ecore_con:
+    ecore_con_shutdown();
+  free_in:
+    eina_strbuf_free(batch.in);
+
+    return -1;
+}
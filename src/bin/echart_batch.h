@@ -0,0 +1,27 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_BATCH_H
+#define ECHART_BATCH_H
+
+int echart_batch_run(Echart_Render *er,
+                     Echart_Backend backend,
+                     unsigned int jobs,
+                     const char *socket_name);
+
+#endif /* ECHART_BATCH_H */
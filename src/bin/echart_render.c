@@ -0,0 +1,438 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Evas.h>
+#include <Ecore.h>
+#include <Ecore_Evas.h>
+
+#include <Echart.h>
+#include <echart_data.h>
+#include <echart_chart.h>
+#include <echart_line.h>
+#include <echart_vbar.h>
+#include <echart_scatter.h>
+#include <echart_ohlc.h>
+#include <echart_candle.h>
+
+#include "echart_render.h"
+
+/* binary PPM, the premultiplied pixels being composed on white */
+static Eina_Bool
+_echart_render_ppm_save(const char *file,
+                        const unsigned int *pixels, int w, int h)
+{
+    unsigned char *line;
+    FILE *f;
+    int i;
+    int j;
+
+    f = fopen(file, "wb");
+    if (!f)
+        return EINA_FALSE;
+
+    line = (unsigned char *)malloc(3 * w);
+    if (!line)
+    {
+        fclose(f);
+        return EINA_FALSE;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (j = 0; j < h; j++)
+    {
+        for (i = 0; i < w; i++)
+        {
+            unsigned int p;
+            unsigned int a;
+
+            p = pixels[j * w + i];
+            a = 255 - (p >> 24);
+            line[3 * i    ] = ((p >> 16) & 0xff) + a;
+            line[3 * i + 1] = ((p >>  8) & 0xff) + a;
+            line[3 * i + 2] = ((p      ) & 0xff) + a;
+        }
+        if (fwrite(line, 3, w, f) != (size_t)w)
+            break;
+    }
+
+    free(line);
+    fclose(f);
+
+    return j == h;
+}
+
+static Eina_Bool
+_echart_render_save(Evas_Object *img, const char *file,
+                    const unsigned int *pixels, int w, int h)
+{
+    if (eina_str_has_extension(file, ".ppm"))
+        return _echart_render_ppm_save(file, pixels, w, h);
+
+    /* other formats are saved by the Evas loaders */
+    evas_object_image_size_set(img, w, h);
+    evas_object_image_data_copy_set(img, (void *)pixels);
+
+    return evas_object_image_save(img, file, NULL, NULL);
+}
+
+static char *
+_echart_render_csv_field_next(char *p)
+{
+    while ((*p == ' ') || (*p == '\t'))
+        p++;
+    if (*p != ',')
+        return NULL;
+
+    return p + 1;
+}
+
+/*
+ * CSV data: the first column is the absciss, the other ones are the
+ * series. An optional first line gives the titles of the columns.
+ * Lines starting with '#' are ignored.
+ */
+static Echart_Data *
+_echart_render_csv_parse(char *s)
+{
+    Echart_Data *d;
+    Echart_Serie **series;
+    char *line;
+    char *next;
+    unsigned int nbr;
+    unsigned int i;
+
+    d = echart_data_new();
+    if (!d)
+        return NULL;
+
+    series = NULL;
+    nbr = 0;
+    for (line = s; line && *line; line = next)
+    {
+        char *p;
+        char *e;
+        size_t len;
+
+        next = strchr(line, '\n');
+        if (next)
+            *next++ = '\0';
+        len = strlen(line);
+        if (len && (line[len - 1] == '\r'))
+            line[len - 1] = '\0';
+        if ((*line == '#') || (*line == '\0'))
+            continue;
+
+        if (!series)
+        {
+            nbr = 1;
+            for (p = line; *p; p++)
+            {
+                if (*p == ',')
+                    nbr++;
+            }
+            if (nbr < 2)
+                goto err_;
+
+            series = (Echart_Serie **)calloc(nbr, sizeof(Echart_Serie *));
+            if (!series)
+                goto err_;
+            for (i = 0; i < nbr; i++)
+            {
+                series[i] = echart_serie_new();
+                if (!series[i])
+                    goto err_;
+            }
+
+            strtod(line, &e);
+            if (e == line)
+            {
+                /* titles */
+                p = line;
+                for (i = 0; i < nbr; i++)
+                {
+                    e = strchr(p, ',');
+                    if (e)
+                        *e = '\0';
+                    while ((*p == ' ') || (*p == '\t'))
+                        p++;
+                    echart_serie_title_set(series[i], p);
+                    if (!e)
+                        break;
+                    p = e + 1;
+                }
+                continue;
+            }
+        }
+
+        p = line;
+        for (i = 0; i < nbr; i++)
+        {
+            double v;
+
+            v = strtod(p, &e);
+            if (e == p)
+                goto err_;
+            echart_serie_value_push(series[i], v);
+            if (i + 1 < nbr)
+            {
+                p = _echart_render_csv_field_next(e);
+                if (!p)
+                    goto err_;
+            }
+        }
+    }
+
+    if (!series)
+        goto err_;
+
+    echart_data_absciss_set(d, series[0]);
+    for (i = 1; i < nbr; i++)
+        echart_data_serie_append(d, series[i]);
+    free(series);
+
+    return d;
+
+  err_:
+    if (series)
+    {
+        for (i = 0; i < nbr; i++)
+            echart_serie_free(series[i]);
+        free(series);
+    }
+    echart_data_free(d);
+
+    return NULL;
+}
+
+Eina_Bool
+echart_render_type_get(const char *str, Echart_Type *type)
+{
+    if (!strcmp(str, "line"))
+        *type = ECHART_TYPE_LINE;
+    else if (!strcmp(str, "vbar"))
+        *type = ECHART_TYPE_VBAR;
+    else if (!strcmp(str, "scatter"))
+        *type = ECHART_TYPE_SCATTER;
+    else if (!strcmp(str, "candle"))
+        *type = ECHART_TYPE_CANDLE;
+    else
+        return EINA_FALSE;
+
+    return EINA_TRUE;
+}
+
+Echart_Data *
+echart_render_data_sample_new(void)
+{
+    Echart_Data *d;
+    Echart_Serie *s;
+
+    d = echart_data_new();
+    echart_data_title_set(d, "Company Performance");
+
+    s = echart_serie_new();
+    echart_serie_title_set(s, "Year");
+    echart_serie_value_push(s, 2004);
+    echart_serie_value_push(s, 2005);
+    echart_serie_value_push(s, 2006);
+    echart_serie_value_push(s, 2007);
+    echart_data_absciss_set(d, s);
+
+    s = echart_serie_new();
+    echart_serie_title_set(s, "Sales");
+    echart_serie_value_push(s, 1000);
+    echart_serie_value_push(s, 1170);
+    echart_serie_value_push(s, 660);
+    echart_serie_value_push(s, 1030);
+    echart_data_serie_append(d, s);
+
+    s = echart_serie_new();
+    echart_serie_title_set(s, "Expenses");
+    echart_serie_value_push(s, 400);
+    echart_serie_value_push(s, 460);
+    echart_serie_value_push(s, 1120);
+    echart_serie_value_push(s, 540);
+    echart_data_serie_append(d, s);
+
+    echart_data_ymin_set(d, 0);
+    echart_data_area_set(d, EINA_TRUE);
+
+    return d;
+}
+
+/*
+ * Load the data from the source: "sample" for the sample data,
+ * otherwise a CSV file. It does not use the canvas, so it can be called
+ * from a thread.
+ */
+Echart_Data *
+echart_render_data_load(const char *source)
+{
+    Echart_Data *d;
+    Eina_File *f;
+    void *map;
+    char *s;
+    size_t size;
+
+    if (!strcmp(source, "sample"))
+        return echart_render_data_sample_new();
+
+    f = eina_file_open(source, EINA_FALSE);
+    if (!f)
+        return NULL;
+
+    d = NULL;
+    size = eina_file_size_get(f);
+    map = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+    if (map)
+    {
+        s = (char *)malloc(size + 1);
+        if (s)
+        {
+            memcpy(s, map, size);
+            s[size] = '\0';
+            d = _echart_render_csv_parse(s);
+            free(s);
+        }
+        eina_file_map_free(f, map);
+    }
+    eina_file_close(f);
+
+    return d;
+}
+
+Evas_Object *
+echart_render_object_add(Evas *evas, Echart_Type type,
+                         const Echart_Chart *chart)
+{
+    Evas_Object *o;
+
+    if (type == ECHART_TYPE_VBAR)
+    {
+        o = echart_vbar_object_add(evas);
+        echart_vbar_object_chart_set(o, chart);
+    }
+    else if (type == ECHART_TYPE_SCATTER)
+    {
+        o = echart_scatter_object_add(evas);
+        echart_scatter_object_chart_set(o, chart);
+    }
+    else if (type == ECHART_TYPE_CANDLE)
+    {
+        o = echart_candle_object_add(evas);
+        echart_candle_object_chart_set(o, chart);
+    }
+    else
+    {
+        o = echart_line_object_add(evas);
+        echart_line_object_chart_set(o, chart);
+    }
+
+    return o;
+}
+
+Eina_Bool
+echart_render_init(Echart_Render *er)
+{
+    er->w = 1;
+    er->h = 1;
+    er->ee = ecore_evas_buffer_new(er->w, er->h);
+    if (!er->ee)
+    {
+        fprintf(stderr, "Could not create the buffer canvas.\n");
+        return EINA_FALSE;
+    }
+
+    er->evas = ecore_evas_get(er->ee);
+
+    er->img = evas_object_image_add(er->evas);
+    evas_object_image_colorspace_set(er->img, EVAS_COLORSPACE_ARGB8888);
+    evas_object_image_alpha_set(er->img, EINA_TRUE);
+
+    return EINA_TRUE;
+}
+
+void
+echart_render_shutdown(Echart_Render *er)
+{
+    evas_object_del(er->img);
+    ecore_evas_free(er->ee);
+    er->ee = NULL;
+}
+
+/*
+ * Render the chart in the buffer canvas, without running the main
+ * loop, and save it in file.
+ */
+Eina_Bool
+echart_render_file(Echart_Render *er,
+                   Echart_Type type,
+                   const Echart_Chart *chart,
+                   const char *file,
+                   Echart_Render_Timing *timing)
+{
+    const unsigned int *pixels;
+    Evas_Object *o;
+    double t0;
+    double t1;
+    double t2;
+    int w;
+    int h;
+    Eina_Bool ret;
+
+    t0 = ecore_time_get();
+
+    echart_chart_size_get(chart, &w, &h);
+    if ((w != er->w) || (h != er->h))
+    {
+        ecore_evas_resize(er->ee, w, h);
+        er->w = w;
+        er->h = h;
+    }
+
+    o = echart_render_object_add(er->evas, type, chart);
+    evas_object_show(o);
+
+    /* the render of the buffer canvas is done when the pixels are got */
+    pixels = (const unsigned int *)ecore_evas_buffer_pixels_get(er->ee);
+    t1 = ecore_time_get();
+
+    ret = pixels && _echart_render_save(er->img, file, pixels, w, h);
+    t2 = ecore_time_get();
+
+    evas_object_del(o);
+
+    if (timing)
+    {
+        timing->render = t1 - t0;
+        timing->save = t2 - t1;
+    }
+
+    return ret;
+}
@@ -0,0 +1,65 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_RENDER_H
+#define ECHART_RENDER_H
+
+typedef enum
+{
+    ECHART_TYPE_LINE,
+    ECHART_TYPE_VBAR,
+    ECHART_TYPE_SCATTER,
+    ECHART_TYPE_CANDLE
+} Echart_Type;
+
+/* buffer canvas, created once and reused for all the charts */
+typedef struct
+{
+    Ecore_Evas *ee;
+    Evas *evas;
+    Evas_Object *img;
+    int w;
+    int h;
+} Echart_Render;
+
+typedef struct
+{
+    double render;
+    double save;
+} Echart_Render_Timing;
+
+Eina_Bool echart_render_type_get(const char *str, Echart_Type *type);
+
+Echart_Data *echart_render_data_sample_new(void);
+
+Echart_Data *echart_render_data_load(const char *source);
+
+Evas_Object *echart_render_object_add(Evas *evas, Echart_Type type,
+                                      const Echart_Chart *chart);
+
+Eina_Bool echart_render_init(Echart_Render *er);
+
+void echart_render_shutdown(Echart_Render *er);
+
+Eina_Bool echart_render_file(Echart_Render *er,
+                             Echart_Type type,
+                             const Echart_Chart *chart,
+                             const char *file,
+                             Echart_Render_Timing *timing);
+
+#endif /* ECHART_RENDER_H */
@@ -0,0 +1,783 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_text.h"
+#include "echart_raster.h"
+#include "echart_ohlc.h"
+#include "echart_candle.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_CANDLE_SMART_OBJ_GET(smart, o, type) \
+{ \
+    char *_echart_candle_smart_str; \
+    if (!o) return; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) return; \
+    _echart_candle_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_candle_smart_str) return; \
+    if (strcmp(_echart_candle_smart_str, type)) return; \
+}
+
+#define ECHART_CANDLE_SMART_OBJ_GET_ERROR(smart, o, type) \
+{ \
+    char *_echart_candle_smart_str; \
+    if (!o) goto _err; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) goto _err; \
+    _echart_candle_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_candle_smart_str) goto _err; \
+    if (strcmp(_echart_candle_smart_str, type)) goto _err; \
+}
+
+#define ECHART_CANDLE_OBJ_NAME "echart_candle_object"
+
+/* number of candles when the interval is not set */
+#define ECHART_CANDLE_AUTO 100
+
+/* part of the interval covered by the body of a candle */
+#define ECHART_CANDLE_BODY 0.7
+
+typedef struct
+{
+    Echart_Smart_Common common;
+    Echart_Ohlc *ohlc;
+    const Echart_Data *data; /* data aggregated in ohlc */
+    double interval; /* 0 if automatic */
+    unsigned int up;
+    unsigned int down;
+} Echart_Smart_Data;
+
+static Evas_Smart *_echart_candle_smart = NULL;
+
+static void
+_echart_candle_smart_add(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = calloc(1, sizeof(Echart_Smart_Data));
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_INIT((Echart_Smart_Common *)sd);
+
+    sd->common.bg = evas_object_rectangle_add(evas_object_evas_get(obj));
+    sd->common.title = evas_object_text_add(evas_object_evas_get(obj));
+    sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
+    sd->common.root = evas_vg_container_add(sd->common.vg);
+    evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+
+    sd->up = 0xff26a69a;
+    sd->down = 0xffef5350;
+
+    evas_object_smart_data_set(obj, sd);
+}
+
+static void
+_echart_candle_smart_del(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
+    {
+        echart_ohlc_free(sd->ohlc);
+        evas_object_del(sd->common.bg);
+        evas_object_del(sd->common.title);
+        evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        free(sd);
+    }
+}
+
+static void
+_echart_candle_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+    Echart_Smart_Data *sd;
+    Evas_Coord ox;
+    Evas_Coord oy;
+    Evas_Coord dx;
+    Evas_Coord dy;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_geometry_get(obj, &ox, &oy, NULL, NULL);
+    dx = x - ox;
+    dy = y - oy;
+
+    evas_object_geometry_get(sd->common.bg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.bg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.title, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.title, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.vg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.vg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+}
+
+static void
+_echart_candle_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
+}
+
+static void
+_echart_candle_smart_show(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_show(sd->common.bg);
+    evas_object_show(sd->common.title);
+    echart_backend_set((Echart_Smart_Common *)sd, EINA_TRUE);
+}
+
+static void
+_echart_candle_smart_hide(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_hide(sd->common.bg);
+    evas_object_hide(sd->common.title);
+    evas_object_hide(sd->common.vg);
+    evas_object_hide(sd->common.img);
+}
+
+static void
+_echart_candle_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_set(sd->common.bg, clip);
+    evas_object_clip_set(sd->common.title, clip);
+    evas_object_clip_set(sd->common.vg, clip);
+    evas_object_clip_set(sd->common.img, clip);
+}
+
+static void
+_echart_candle_smart_clip_unset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_unset(sd->common.bg);
+    evas_object_clip_unset(sd->common.title);
+    evas_object_clip_unset(sd->common.vg);
+    evas_object_clip_unset(sd->common.img);
+}
+
+/*
+ * Aggregate the ticks appended since the last calculation, only the
+ * last candle and the new ones being updated. All the ticks are
+ * aggregated again when the data or the interval change.
+ */
+static const Echart_Ohlc *
+_echart_candle_ohlc_update(Echart_Smart_Data *sd)
+{
+    const Echart_Data *data;
+    const Echart_Serie *absciss;
+    const Eina_List *series;
+
+    data = echart_chart_data_get(sd->common.chart);
+    absciss = echart_data_absciss_get(data);
+    series = echart_data_series_get(data);
+    if (!absciss || !series)
+        return NULL;
+
+    if (sd->ohlc && (data != sd->data))
+    {
+        echart_ohlc_free(sd->ohlc);
+        sd->ohlc = NULL;
+    }
+    sd->data = data;
+
+    if (!sd->ohlc)
+    {
+        double interval;
+
+        interval = sd->interval;
+        if (!(interval > 0))
+        {
+            double xmin;
+            double xmax;
+
+            echart_serie_interval_get(absciss, &xmin, &xmax);
+            interval = (xmax - xmin) / ECHART_CANDLE_AUTO;
+            if (!(interval > 0))
+                interval = 1;
+        }
+        sd->ohlc = echart_ohlc_new(interval);
+        if (!sd->ohlc)
+            return NULL;
+    }
+
+    echart_ohlc_series_update(sd->ohlc, absciss, eina_list_data_get(series));
+
+    return sd->ohlc;
+}
+
+/* candles [first, last] intersecting [xmin, xmax], they are sorted */
+static Eina_Bool
+_echart_candle_visible_get(const Echart_Ohlc_Candle *candles, unsigned int nbr,
+                           double interval, double xmin, double xmax,
+                           unsigned int *first, unsigned int *last)
+{
+    unsigned int lo;
+    unsigned int hi;
+
+    lo = 0;
+    hi = nbr;
+    while (lo < hi)
+    {
+        unsigned int mid;
+
+        mid = lo + (hi - lo) / 2;
+        if (candles[mid].t + interval < xmin)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *first = lo;
+
+    hi = nbr;
+    while (lo < hi)
+    {
+        unsigned int mid;
+
+        mid = lo + (hi - lo) / 2;
+        if (candles[mid].t <= xmax)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo <= *first)
+        return EINA_FALSE;
+    *last = lo - 1;
+
+    return EINA_TRUE;
+}
+
+/* the candles span [first candle, last candle + interval] by default */
+static Eina_Bool
+_echart_candle_viewport_get(Echart_Smart_Data *sd,
+                            const Echart_Ohlc *ohlc,
+                            double *xmin, double *xmax,
+                            double *ymin, double *ymax)
+{
+    const Echart_Ohlc_Candle *candles;
+    unsigned int nbr;
+
+    if (!echart_viewport_get((Echart_Smart_Common *)sd,
+                             xmin, xmax, ymin, ymax))
+        return EINA_FALSE;
+
+    candles = echart_ohlc_candles_get(ohlc, &nbr);
+    if (!candles)
+        return EINA_FALSE;
+
+    if (!sd->common.viewport.x_set)
+    {
+        *xmin = candles[0].t;
+        *xmax = candles[nbr - 1].t + echart_ohlc_interval_get(ohlc);
+    }
+
+    return EINA_TRUE;
+}
+
+/* pixel rectangle of the wick and of the body of a candle */
+static void
+_echart_candle_rects_get(const Echart_Raster_Transform *t,
+                         const Echart_Ohlc_Candle *c, double interval,
+                         double *wick, double *body)
+{
+    double xc;
+    double y0;
+    double y1;
+
+    xc = t->ax * (c->t + interval / 2) + t->bx;
+    wick[0] = xc - 0.5;
+    wick[1] = t->ay * c->high + t->by;
+    wick[2] = xc + 0.5;
+    wick[3] = t->ay * c->low + t->by;
+
+    y0 = t->ay * ((c->open > c->close) ? c->open : c->close) + t->by;
+    y1 = t->ay * ((c->open > c->close) ? c->close : c->open) + t->by;
+    /* a candle without move is a line */
+    if (y1 - y0 < 1)
+        y1 = y0 + 1;
+    body[0] = t->ax * (c->t + interval * (1 - ECHART_CANDLE_BODY) / 2) + t->bx;
+    body[1] = y0;
+    body[2] = t->ax * (c->t + interval * (1 + ECHART_CANDLE_BODY) / 2) + t->bx;
+    body[3] = y1;
+    if (body[2] - body[0] < 1)
+    {
+        body[0] = wick[0];
+        body[2] = wick[2];
+    }
+}
+
+static void
+_echart_candle_raster_draw(Echart_Smart_Data *sd,
+                           const Echart_Ohlc *ohlc,
+                           double xmin, double xmax,
+                           double ymin, double ymax)
+{
+    Echart_Raster r;
+    Echart_Raster_Transform t;
+    const Echart_Ohlc_Candle *candles;
+    unsigned int col;
+    unsigned int nbr;
+    unsigned int first;
+    unsigned int last;
+    unsigned int i;
+    double interval;
+    int gyn;
+
+    if (!echart_raster_begin(&r, sd->common.img,
+                             sd->common.w_vg, sd->common.h_vg))
+        return;
+
+    echart_raster_clear(&r, 0x00000000);
+
+    /* axis */
+    echart_raster_rect_fill(&r,
+                            PAD(0), PAD(0),
+                            PAD(1), sd->common.h_vg - PAD(0),
+                            0xff000000);
+    echart_raster_rect_fill(&r,
+                            PAD(0), sd->common.h_vg - PAD(1),
+                            sd->common.w_vg - PAD(0), sd->common.h_vg - PAD(0),
+                            0xff000000);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        int k;
+
+        for (k = 1; k <= gyn; k++)
+        {
+            double y = k * (ymax - ymin) / gyn + ymin;
+            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            echart_raster_rect_fill(&r,
+                                    PAD(0.5), j + PAD(0),
+                                    sd->common.w_vg - PAD2(0.5), j + PAD(1),
+                                    col);
+        }
+    }
+
+    echart_raster_transform_set(&t,
+                                xmin, xmax,
+                                ymin, ymax,
+                                sd->common.padding, sd->common.padding,
+                                sd->common.w_vg - 2 * sd->common.padding,
+                                sd->common.h_vg - 2 * sd->common.padding);
+
+    /* candles */
+    candles = echart_ohlc_candles_get(ohlc, &nbr);
+    interval = echart_ohlc_interval_get(ohlc);
+    if (_echart_candle_visible_get(candles, nbr, interval, xmin, xmax,
+                                   &first, &last))
+    {
+        for (i = first; i <= last; i++)
+        {
+            double wick[4];
+            double body[4];
+
+            col = (candles[i].close >= candles[i].open) ? sd->up : sd->down;
+            _echart_candle_rects_get(&t, candles + i, interval, wick, body);
+            echart_raster_rect_fill(&r, wick[0], wick[1], wick[2], wick[3], col);
+            echart_raster_rect_fill(&r, body[0], body[1], body[2], body[3], col);
+        }
+    }
+
+    echart_raster_end(&r, sd->common.img);
+}
+
+static void
+_echart_candle_rect_append(Efl_VG *shape, const double *rect)
+{
+    evas_vg_shape_append_move_to(shape, rect[0], rect[1]);
+    evas_vg_shape_append_line_to(shape, rect[2], rect[1]);
+    evas_vg_shape_append_line_to(shape, rect[2], rect[3]);
+    evas_vg_shape_append_line_to(shape, rect[0], rect[3]);
+    evas_vg_shape_append_close(shape);
+}
+
+static void
+_echart_candle_shape_color_set(Efl_VG *shape, unsigned int col)
+{
+    evas_vg_node_color_set(shape,
+                           COL_TO_R(col),
+                           COL_TO_G(col),
+                           COL_TO_B(col),
+                           COL_TO_A(col));
+}
+
+static void
+_echart_candle_smart_calculate(Evas_Object *obj)
+{
+    Echart_Font_Style fs;
+    Echart_Raster_Transform t;
+    const Echart_Ohlc *ohlc;
+    const Echart_Ohlc_Candle *candles;
+    Echart_Smart_Data *sd;
+    unsigned int col;
+    unsigned int nbr;
+    unsigned int first;
+    unsigned int last;
+    unsigned int i;
+    Efl_VG *shape;
+    Efl_VG *up;
+    Efl_VG *down;
+    double interval;
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    int gyn;
+    int w;
+    int h;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    sd->common.padding = 5;
+
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
+    col = echart_chart_background_color_get(sd->common.chart);
+
+    /* background */
+    echart_background_set((Echart_Smart_Common *)sd, w, h, col);
+
+    /* title */
+    if (echart_chart_title_get(sd->common.chart))
+    {
+        Evas_Coord w_title;
+
+        echart_chart_title_style_get(sd->common.chart, &fs);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
+        evas_object_move(sd->common.title, (w - w_title) / 2, 0);
+    }
+
+    /* vg */
+    echart_vg_set((Echart_Smart_Common *)sd);
+    echart_backend_set((Echart_Smart_Common *)sd, evas_object_visible_get(obj));
+    echart_vg_reset((Echart_Smart_Common *)sd);
+
+    ohlc = _echart_candle_ohlc_update(sd);
+    if (!ohlc)
+        return;
+
+    if (!_echart_candle_viewport_get(sd, ohlc, &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    if (sd->common.backend == ECHART_BACKEND_RASTER)
+    {
+        _echart_candle_raster_draw(sd, ohlc, xmin, xmax, ymin, ymax);
+        return;
+    }
+
+    /* axis */
+    shape = evas_vg_shape_add(sd->common.root);
+    evas_vg_shape_append_move_to(shape, PAD(0.5), PAD(0.5));
+    evas_vg_shape_append_line_to(shape, PAD(0.5), sd->common.h_vg - PAD(0.5));
+    evas_vg_shape_append_line_to(shape, sd->common.w_vg - PAD(0.5), sd->common.h_vg - PAD(0.5));
+    evas_vg_shape_stroke_width_set(shape, 1);
+    evas_vg_shape_stroke_color_set(shape, 0, 0, 0, 255);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        int k;
+
+        for (k = 1; k <= gyn; k++)
+        {
+            double y = k * (ymax - ymin) / gyn + ymin;
+            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            shape = evas_vg_shape_add(sd->common.root);
+            evas_vg_shape_append_move_to(shape, PAD(0.5), j + PAD(0.5));
+            evas_vg_shape_append_line_to(shape, sd->common.w_vg - PAD2(0.5), j + PAD(0.5));
+            evas_vg_shape_stroke_width_set(shape, 1);
+            evas_vg_shape_stroke_color_set(shape,
+                                           COL_TO_R(col), COL_TO_G(col), COL_TO_B(col), COL_TO_A(col));
+        }
+    }
+
+    /* candles, one shape for the up ones, one for the down ones */
+    candles = echart_ohlc_candles_get(ohlc, &nbr);
+    interval = echart_ohlc_interval_get(ohlc);
+    if (!_echart_candle_visible_get(candles, nbr, interval, xmin, xmax,
+                                    &first, &last))
+        return;
+
+    echart_raster_transform_set(&t,
+                                xmin, xmax,
+                                ymin, ymax,
+                                sd->common.padding, sd->common.padding,
+                                sd->common.w_vg - 2 * sd->common.padding,
+                                sd->common.h_vg - 2 * sd->common.padding);
+
+    up = evas_vg_shape_add(sd->common.root);
+    down = evas_vg_shape_add(sd->common.root);
+    for (i = first; i <= last; i++)
+    {
+        double wick[4];
+        double body[4];
+
+        _echart_candle_rects_get(&t, candles + i, interval, wick, body);
+        shape = (candles[i].close >= candles[i].open) ? up : down;
+        _echart_candle_rect_append(shape, wick);
+        _echart_candle_rect_append(shape, body);
+    }
+    _echart_candle_shape_color_set(up, sd->up);
+    _echart_candle_shape_color_set(down, sd->down);
+}
+
+static void
+_echart_candle_smart_init(void)
+{
+    static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION(ECHART_CANDLE_OBJ_NAME);
+
+    if (_echart_candle_smart) return;
+
+    if (!sc.add)
+    {
+        sc.add = _echart_candle_smart_add;
+        sc.del = _echart_candle_smart_del;
+        sc.move = _echart_candle_smart_move;
+        sc.resize = _echart_candle_smart_resize;
+        sc.show = _echart_candle_smart_show;
+        sc.hide = _echart_candle_smart_hide;
+        sc.clip_set = _echart_candle_smart_clip_set;
+        sc.clip_unset = _echart_candle_smart_clip_unset;
+        sc.calculate = _echart_candle_smart_calculate;
+    }
+    _echart_candle_smart = evas_smart_class_new(&sc);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Evas_Object *
+echart_candle_object_add(Evas *evas)
+{
+    Evas_Object *obj;
+
+    _echart_candle_smart_init();
+    obj = evas_object_smart_add(evas, _echart_candle_smart);
+
+    return obj;
+}
+
+EAPI void
+echart_candle_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+    INF("chart set");
+
+    sd->common.chart = chart;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_candle_object_interval_set(Evas_Object *obj, double interval)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    if ((interval < 0) || (interval == sd->interval))
+        return;
+
+    sd->interval = interval;
+    echart_ohlc_free(sd->ohlc);
+    sd->ohlc = NULL;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_candle_object_colors_set(Evas_Object *obj, unsigned int up, unsigned int down)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    sd->up = up;
+    sd->down = down;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI const Echart_Ohlc *
+echart_candle_object_ohlc_get(const Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET_ERROR(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    return sd->ohlc;
+
+  _err:
+    return NULL;
+}
+
+EAPI void
+echart_candle_object_viewport_set(Evas_Object *obj,
+                                   double xmin, double xmax,
+                                   double ymin, double ymax)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    echart_viewport_set((Echart_Smart_Common *)sd, xmin, xmax, ymin, ymax);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_candle_object_viewport_get(const Evas_Object *obj,
+                                   double *xmin, double *xmax,
+                                   double *ymin, double *ymax)
+{
+    Echart_Smart_Data *sd;
+    double x0 = 0;
+    double x1 = 0;
+    double y0 = 0;
+    double y1 = 0;
+
+    if (xmin) *xmin = 0;
+    if (xmax) *xmax = 0;
+    if (ymin) *ymin = 0;
+    if (ymax) *ymax = 0;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    echart_viewport_get((Echart_Smart_Common *)sd, &x0, &x1, &y0, &y1);
+    if (xmin) *xmin = x0;
+    if (xmax) *xmax = x1;
+    if (ymin) *ymin = y0;
+    if (ymax) *ymax = y1;
+}
+
+EAPI void
+echart_candle_object_viewport_reset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    echart_viewport_reset((Echart_Smart_Common *)sd);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_candle_object_pan(Evas_Object *obj, double dx, double dy)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    echart_viewport_pan((Echart_Smart_Common *)sd, dx, dy);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_candle_object_zoom(Evas_Object *obj, double factor, double x, double y)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_CANDLE_SMART_OBJ_GET(sd, obj, ECHART_CANDLE_OBJ_NAME);
+
+    echart_viewport_zoom((Echart_Smart_Common *)sd, factor, x, y);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
@@ -0,0 +1,43 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_CANDLE_H
+#define ECHART_CANDLE_H
+
+/*
+ * Candlesticks of the ticks of the chart data: the absciss is the
+ * timestamps and the first serie the prices. Without interval, about
+ * 100 candles span the ticks of the first calculation.
+ */
+EAPI Evas_Object *echart_candle_object_add(Evas *evas);
+EAPI void echart_candle_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
+EAPI void echart_candle_object_interval_set(Evas_Object *obj, double interval);
+EAPI void echart_candle_object_colors_set(Evas_Object *obj, unsigned int up, unsigned int down);
+EAPI const Echart_Ohlc *echart_candle_object_ohlc_get(const Evas_Object *obj);
+
+EAPI void echart_candle_object_viewport_set(Evas_Object *obj,
+                                            double xmin, double xmax,
+                                            double ymin, double ymax);
+EAPI void echart_candle_object_viewport_get(const Evas_Object *obj,
+                                            double *xmin, double *xmax,
+                                            double *ymin, double *ymax);
+EAPI void echart_candle_object_viewport_reset(Evas_Object *obj);
+EAPI void echart_candle_object_pan(Evas_Object *obj, double dx, double dy);
+EAPI void echart_candle_object_zoom(Evas_Object *obj, double factor, double x, double y);
+
+#endif /* ECHART_CANDLE_H */
@@ -48,6 +48,7 @@ struct _Echart_Chart
     Echart_Text title_haxis;
     Echart_Text title_vaxis;
     unsigned int bg_color;
+    Echart_Backend backend;
     int width;
     int height;
     struct
@@ -451,12 +452,37 @@ echart_chart_sub_grid_color_get(const Echart_Chart *chart)
     return chart->sub_grid.color;
 }
 
+EAPI void
+echart_chart_backend_set(Echart_Chart *chart, Echart_Backend backend)
+{
+    if (!chart ||
+        ((backend != ECHART_BACKEND_VG) && (backend != ECHART_BACKEND_RASTER)))
+        return;
+
+    chart->backend = backend;
+}
+
+EAPI Echart_Backend
+echart_chart_backend_get(const Echart_Chart *chart)
+{
+    if (!chart)
+        return ECHART_BACKEND_VG;
+
+    return chart->backend;
+}
+
 EAPI void
 echart_chart_data_set(Echart_Chart *chart, Echart_Data *data)
 {
     if (!chart || !data)
         return;
 
+    /*
+     * the chart takes over the reference of the caller, and releases
+     * the one it holds, even if it is the same data
+     */
+    if (chart->data)
+        echart_data_free(chart->data);
     chart->data = data;
 }
 
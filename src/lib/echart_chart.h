@@ -30,6 +30,12 @@ typedef struct
     Eina_Bool italic : 1;
 } Echart_Font_Style;
 
+typedef enum
+{
+    ECHART_BACKEND_VG,    /* series are Efl_VG shapes (default) */
+    ECHART_BACKEND_RASTER /* series are rasterized in an ARGB32 image */
+} Echart_Backend;
+
 EAPI Echart_Chart *echart_chart_new(int width, int height);
 EAPI void echart_chart_free(Echart_Chart *chart);
 
@@ -68,6 +74,8 @@ EAPI void echart_chart_sub_grid_nbr_set(Echart_Chart *chart, int grid_x_nbr, int
 EAPI void echart_chart_sub_grid_nbr_get(const Echart_Chart *chart, int *grid_x_nbr, int *grid_y_nbr);
 EAPI void echart_chart_sub_grid_color_set(Echart_Chart *chart, uint8_t a, uint8_t r, uint8_t g, uint8_t b);
 EAPI unsigned int echart_chart_sub_grid_color_get(const Echart_Chart *chart);
+EAPI void echart_chart_backend_set(Echart_Chart *chart, Echart_Backend backend);
+EAPI Echart_Backend echart_chart_backend_get(const Echart_Chart *chart);
 EAPI void echart_chart_data_set(Echart_Chart *chart, Echart_Data *data);
 EAPI const Echart_Data *echart_chart_data_get(const Echart_Chart *chart);
 
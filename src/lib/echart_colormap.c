@@ -0,0 +1,407 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <float.h>
+#include <math.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_thread.h"
+#include "echart_heatmap.h"
+#include "echart_colormap.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * The values are quantized once in LUT indices, when they are set or
+ * appended, so that drawing a pixel is only integer arithmetic and a
+ * table lookup. The source cells of each pixel column and row are
+ * computed once per draw, then bands of rows are drawn in parallel.
+ */
+
+#define ECHART_COLORMAP_BAND_H_MIN 16
+
+/* viridis */
+static const unsigned int _echart_colormap_default[] =
+{
+    0xff440154, 0xff3b528b, 0xff21918c, 0xff5ec962, 0xfffde725
+};
+
+typedef struct
+{
+    const Echart_Colormap *cm;
+    unsigned int *data;
+    int stride;
+    int h;
+    int x0;
+    int x1;
+    int band_h;
+    int x_end; /* first pixel column without cell */
+    const unsigned int *off0; /* offset of the left cell, per pixel column */
+    const unsigned int *off1; /* offset of the right cell */
+    const unsigned int *fx;   /* weight of the right cell, in [0, 256] */
+    const unsigned int *r0;   /* bottom cell, per pixel row */
+    const unsigned int *r1;   /* top cell */
+    const unsigned int *fy;   /* weight of the top cell, in [0, 256] */
+} Echart_Colormap_Job;
+
+static void
+_echart_colormap_rows_draw(const Echart_Colormap_Job *job, int y0, int y1)
+{
+    const unsigned char *q;
+    const unsigned int *lut;
+    int x_end;
+    int i;
+    int j;
+
+    q = job->cm->q;
+    lut = job->cm->lut;
+    x_end = (job->x_end < job->x1) ? job->x_end : job->x1;
+
+    for (j = y0; j < y1; j++)
+    {
+        unsigned int *p;
+        unsigned int r0;
+
+        p = job->data + j * job->stride + job->x0;
+        r0 = job->r0[j];
+
+        if (job->cm->filter == ECHART_HEATMAP_FILTER_NEAREST)
+        {
+            for (i = 0; i < x_end - job->x0; i++)
+                p[i] = lut[q[job->off0[i] + r0]];
+        }
+        else
+        {
+            unsigned int r1;
+            unsigned int fy;
+
+            r1 = job->r1[j];
+            fy = job->fy[j];
+            for (i = 0; i < x_end - job->x0; i++)
+            {
+                unsigned int fx;
+                unsigned int b;
+                unsigned int t;
+
+                fx = job->fx[i];
+                b = q[job->off0[i] + r0] * (256 - fx) + q[job->off1[i] + r0] * fx;
+                t = q[job->off0[i] + r1] * (256 - fx) + q[job->off1[i] + r1] * fx;
+                p[i] = lut[(b * (256 - fy) + t * fy) >> 16];
+            }
+        }
+
+        /* no cell yet on the right */
+        for (i = x_end - job->x0; i < job->x1 - job->x0; i++)
+            p[i] = 0x00000000;
+    }
+}
+
+static void
+_echart_colormap_band_job(void *data, unsigned int idx)
+{
+    const Echart_Colormap_Job *job;
+    int y0;
+    int y1;
+
+    job = data;
+    y0 = idx * job->band_h;
+    y1 = y0 + job->band_h;
+    if (y1 > job->h)
+        y1 = job->h;
+
+    _echart_colormap_rows_draw(job, y0, y1);
+}
+
+/* cell i of n cells spanning size pixels, for the pixel p, and its weight */
+static void
+_echart_colormap_cell_get(int p, int size, unsigned int n,
+                          double span, Eina_Bool bilinear,
+                          unsigned int *c0, unsigned int *c1,
+                          unsigned int *f)
+{
+    double u;
+
+    u = (p + 0.5) * span / size;
+    if (!bilinear)
+    {
+        *c0 = (unsigned int)u;
+        if (*c0 >= n)
+            *c0 = n - 1;
+        *c1 = *c0;
+        *f = 0;
+        return;
+    }
+
+    /* the cells are centered on i + 0.5 */
+    u -= 0.5;
+    if (u < 0)
+        u = 0;
+    *c0 = (unsigned int)u;
+    if (*c0 >= n - 1)
+    {
+        *c0 = n - 1;
+        *c1 = n - 1;
+        *f = 0;
+        return;
+    }
+    *c1 = *c0 + 1;
+    *f = (unsigned int)((u - *c0) * 256 + 0.5);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*
+ * Fill lut with the colors, evenly spaced from the first entry to the
+ * last one and linearly interpolated. The default ramp is used if there
+ * is no color.
+ */
+void
+echart_colormap_lut_set(unsigned int *lut,
+                        const unsigned int *colors, unsigned int nbr)
+{
+    unsigned int k;
+
+    if (!colors || !nbr)
+    {
+        colors = _echart_colormap_default;
+        nbr = sizeof(_echart_colormap_default) / sizeof(unsigned int);
+    }
+
+    for (k = 0; k < ECHART_COLORMAP_SIZE; k++)
+    {
+        unsigned int c0;
+        unsigned int c1;
+        unsigned int a;
+        unsigned int r;
+        unsigned int g;
+        unsigned int b;
+        unsigned int i;
+        double pos;
+        double f;
+
+        pos = (double)k * (nbr - 1) / (ECHART_COLORMAP_SIZE - 1);
+        i = (unsigned int)pos;
+        if (i >= nbr - 1)
+            i = (nbr > 1) ? nbr - 2 : 0;
+        f = pos - i;
+        c0 = colors[i];
+        c1 = (nbr > 1) ? colors[i + 1] : c0;
+
+        a = (unsigned int)(((c0 >> 24) & 0xff) * (1 - f) + ((c1 >> 24) & 0xff) * f + 0.5);
+        r = (unsigned int)(((c0 >> 16) & 0xff) * (1 - f) + ((c1 >> 16) & 0xff) * f + 0.5);
+        g = (unsigned int)(((c0 >>  8) & 0xff) * (1 - f) + ((c1 >>  8) & 0xff) * f + 0.5);
+        b = (unsigned int)(((c0      ) & 0xff) * (1 - f) + ((c1      ) & 0xff) * f + 0.5);
+
+        /* premultiplied */
+        lut[k] = (a << 24) |
+                 (((r * a) / 255) << 16) |
+                 (((g * a) / 255) << 8) |
+                 ((b * a) / 255);
+    }
+}
+
+/* interval of the values, the NaN being ignored */
+void
+echart_colormap_range_get(const double *values, size_t count,
+                          double *min, double *max)
+{
+    double mn;
+    double mx;
+    size_t k;
+
+    mn = DBL_MAX;
+    mx = -DBL_MAX;
+    for (k = 0; k < count; k++)
+    {
+        if (values[k] < mn) mn = values[k];
+        if (values[k] > mx) mx = values[k];
+    }
+
+    if (mn > mx)
+    {
+        mn = 0;
+        mx = 0;
+    }
+
+    *min = mn;
+    *max = mx;
+}
+
+void
+echart_colormap_quantize(const double *values, size_t count,
+                         double min, double max,
+                         unsigned char *q)
+{
+    double scale;
+    size_t k;
+
+    scale = (max > min) ? (ECHART_COLORMAP_SIZE - 1) / (max - min) : 0;
+    for (k = 0; k < count; k++)
+    {
+        double t;
+
+        t = (values[k] - min) * scale + 0.5;
+        /* NaN are mapped on the first entry */
+        if (!(t > 0))
+            t = 0;
+        if (t > ECHART_COLORMAP_SIZE - 1)
+            t = ECHART_COLORMAP_SIZE - 1;
+        q[k] = (unsigned char)t;
+    }
+}
+
+/*
+ * First pixel column of an image w pixels wide whose color depends on
+ * the columns of the matrix from column. It is conservative, it can be
+ * a few pixels on the left.
+ */
+int
+echart_colormap_pixel_get(const Echart_Colormap *cm, int w,
+                          unsigned int column)
+{
+    double x;
+
+    if (!cm->capacity)
+        return 0;
+
+    /* the bilinear filter also reads the column on the left */
+    x = (double)column;
+    if (cm->filter == ECHART_HEATMAP_FILTER_BILINEAR)
+        x -= 1;
+    x = floor(x * w / cm->capacity) - 1;
+    if (x < 0)
+        return 0;
+    if (x > w)
+        return w;
+
+    return (int)x;
+}
+
+/*
+ * Draw the pixel columns [x0, x1[ of the image w x h, the pixels on the
+ * right of the last column of the matrix being transparent.
+ */
+void
+echart_colormap_draw(const Echart_Colormap *cm,
+                     unsigned int *data, int stride, int w, int h,
+                     int x0, int x1)
+{
+    Echart_Colormap_Job job;
+    unsigned int *tables;
+    unsigned int nbr_bands;
+    Eina_Bool bilinear;
+    int i;
+    int j;
+
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 > w)
+        x1 = w;
+    if ((x0 >= x1) || (h <= 0) || !cm->rows || !cm->capacity)
+        return;
+
+    tables = (unsigned int *)malloc((3 * (x1 - x0) + 3 * h) * sizeof(unsigned int));
+    if (!tables)
+    {
+        ERR("Could not allocate the resampling tables.");
+        return;
+    }
+
+    bilinear = cm->filter == ECHART_HEATMAP_FILTER_BILINEAR;
+
+    job.cm = cm;
+    job.data = data;
+    job.stride = stride;
+    job.h = h;
+    job.x0 = x0;
+    job.x1 = x1;
+    job.off0 = tables;
+    job.off1 = job.off0 + (x1 - x0);
+    job.fx = job.off1 + (x1 - x0);
+    job.r0 = job.fx + (x1 - x0);
+    job.r1 = job.r0 + h;
+    job.fy = job.r1 + h;
+
+    /* a pixel column has a cell if its center is in a column of the matrix */
+    job.x_end = x1;
+    for (i = x0; i < x1; i++)
+    {
+        unsigned int c0;
+        unsigned int c1;
+        unsigned int f;
+
+        if ((unsigned int)((i + 0.5) * cm->capacity / w) >= cm->columns)
+        {
+            job.x_end = i;
+            break;
+        }
+        _echart_colormap_cell_get(i, w, cm->columns, cm->capacity, bilinear,
+                                  &c0, &c1, &f);
+        tables[i - x0] = c0 * cm->rows;
+        tables[(x1 - x0) + i - x0] = c1 * cm->rows;
+        tables[2 * (x1 - x0) + i - x0] = f;
+    }
+
+    /* the row 0 of the image is the top one */
+    for (j = 0; j < h; j++)
+    {
+        unsigned int r0;
+        unsigned int r1;
+        unsigned int f;
+
+        _echart_colormap_cell_get(h - 1 - j, h, cm->rows, cm->rows, bilinear,
+                                  &r0, &r1, &f);
+        tables[3 * (x1 - x0) + j] = r0;
+        tables[3 * (x1 - x0) + h + j] = r1;
+        tables[3 * (x1 - x0) + 2 * h + j] = f;
+    }
+
+    nbr_bands = 4 * echart_thread_count();
+    if (nbr_bands > (unsigned int)(h / ECHART_COLORMAP_BAND_H_MIN))
+        nbr_bands = h / ECHART_COLORMAP_BAND_H_MIN;
+    if (nbr_bands < 1)
+        nbr_bands = 1;
+    job.band_h = (h + nbr_bands - 1) / nbr_bands;
+    nbr_bands = (h + job.band_h - 1) / job.band_h;
+
+    echart_thread_run(nbr_bands, _echart_colormap_band_job, &job);
+
+    free(tables);
+}
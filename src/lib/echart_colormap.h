@@ -0,0 +1,52 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_COLORMAP_H
+#define ECHART_COLORMAP_H
+
+#define ECHART_COLORMAP_SIZE 256
+
+/* matrix of LUT indices, stored column by column, row 0 at the bottom */
+typedef struct
+{
+    const unsigned char *q;
+    unsigned int rows;
+    unsigned int columns;
+    unsigned int capacity; /* columns spanning the width of the image */
+    const unsigned int *lut; /* ECHART_COLORMAP_SIZE premultiplied colors */
+    Echart_Heatmap_Filter filter;
+} Echart_Colormap;
+
+void echart_colormap_lut_set(unsigned int *lut,
+                             const unsigned int *colors, unsigned int nbr);
+
+void echart_colormap_range_get(const double *values, size_t count,
+                               double *min, double *max);
+
+void echart_colormap_quantize(const double *values, size_t count,
+                              double min, double max,
+                              unsigned char *q);
+
+int echart_colormap_pixel_get(const Echart_Colormap *cm, int w,
+                              unsigned int column);
+
+void echart_colormap_draw(const Echart_Colormap *cm,
+                          unsigned int *data, int stride, int w, int h,
+                          int x0, int x1);
+
+#endif /* ECHART_COLORMAP_H */
@@ -20,6 +20,12 @@
 # include <config.h>
 #endif
 
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <math.h>
+
 #include <Eina.h>
 #include <Evas.h>
 
@@ -28,6 +34,39 @@
 #include "echart_data.h"
 #include "echart_chart.h"
 #include "echart_common.h"
+#include "echart_text.h"
+
+/* labels measured to find the extent of the labels of an axis */
+#define ECHART_LABELS_SAMPLES 16
+
+/* pixels between two labels */
+#define ECHART_LABELS_GAP 6
+
+static void
+_echart_pointer_move_cb(void *data, Evas *evas EINA_UNUSED, Evas_Object *o EINA_UNUSED, void *event)
+{
+    Echart_Smart_Common *esc;
+    Evas_Event_Mouse_Move *ev;
+
+    esc = evas_object_smart_data_get(data);
+    ev = event;
+
+    esc->pointer_x = ev->cur.canvas.x;
+    esc->pointer_y = ev->cur.canvas.y;
+    esc->pointer_in = EINA_TRUE;
+    echart_object_changed(esc, data, EINA_FALSE);
+}
+
+static void
+_echart_pointer_out_cb(void *data, Evas *evas EINA_UNUSED, Evas_Object *o EINA_UNUSED, void *event EINA_UNUSED)
+{
+    Echart_Smart_Common *esc;
+
+    esc = evas_object_smart_data_get(data);
+
+    esc->pointer_in = EINA_FALSE;
+    echart_object_changed(esc, data, EINA_FALSE);
+}
 
 void
 echart_background_set(Echart_Smart_Common *esc,
@@ -46,12 +85,139 @@ echart_vg_set(Echart_Smart_Common *esc)
     int w;
     int h;
 
-    echart_chart_size_get(esc->chart, &w, &h);
+    echart_size_get(esc, &w, &h);
     echart_offsets_get(esc->title, &offsets);
     esc->w_vg = w - (offsets.left + offsets.right);
-    esc->h_vg = h - (offsets.top + offsets.bottom);
+    esc->h_vg = h - (offsets.top + offsets.bottom + esc->bottom);
     evas_object_move(esc->vg, offsets.left, offsets.top);
     evas_object_resize(esc->vg, esc->w_vg, esc->h_vg);
+    if (esc->img)
+    {
+        evas_object_move(esc->img, offsets.left, offsets.top);
+        evas_object_resize(esc->img, esc->w_vg, esc->h_vg);
+    }
+    if (esc->overlay)
+    {
+        evas_object_move(esc->overlay, offsets.left, offsets.top);
+        evas_object_resize(esc->overlay, esc->w_vg, esc->h_vg);
+    }
+}
+
+void
+echart_backend_set(Echart_Smart_Common *esc, Eina_Bool visible)
+{
+    Evas_Object *on;
+    Evas_Object *off;
+
+    esc->backend = echart_chart_backend_get(esc->chart);
+    if (esc->backend == ECHART_BACKEND_RASTER)
+    {
+        on = esc->img;
+        off = esc->vg;
+    }
+    else
+    {
+        on = esc->vg;
+        off = esc->img;
+    }
+
+    if (off)
+        evas_object_hide(off);
+    if (on && visible)
+        evas_object_show(on);
+    if (esc->overlay && visible)
+        evas_object_show(esc->overlay);
+}
+
+/*
+ * Replace the root node of the VG object by an empty one, the previous
+ * nodes being freed with it. It must be called before drawing again.
+ */
+void
+echart_vg_reset(Echart_Smart_Common *esc)
+{
+    esc->root = evas_vg_container_add(esc->vg);
+    evas_object_vg_root_node_set(esc->vg, esc->root);
+}
+
+/*
+ * Layer of the interaction feedback (hover dot, crosshair...), stacked
+ * above the data. It is a separate object, so that updating it only
+ * redraws its own shapes, and never the paths of the series. It must be
+ * added after the vg and image objects to be above them.
+ */
+void
+echart_overlay_add(Echart_Smart_Common *esc, Evas *evas)
+{
+    esc->overlay = evas_object_vg_add(evas);
+    esc->overlay_root = evas_vg_container_add(esc->overlay);
+    evas_object_vg_root_node_set(esc->overlay, esc->overlay_root);
+    /* the mouse events are for the data layer below */
+    evas_object_pass_events_set(esc->overlay, EINA_TRUE);
+}
+
+/*
+ * Request a frame of the smart object obj. Its calculate function is
+ * called at most once per frame, whatever the number of requests, so
+ * the data changes and the mouse moves between two frames are handled
+ * once. If layout is EINA_FALSE, only the pointer has changed and the
+ * data do not need to be drawn again.
+ */
+void
+echart_object_changed(Echart_Smart_Common *esc, Evas_Object *obj,
+                      Eina_Bool layout)
+{
+    if (layout)
+        esc->need_layout = EINA_TRUE;
+    else
+        esc->pointer_changed = EINA_TRUE;
+    evas_object_smart_changed(obj);
+}
+
+/*
+ * Resize of the smart object obj. The layout is done at the next frame,
+ * and the objects that handle need_resize only compute again what
+ * depends on the size.
+ */
+void
+echart_object_resize(Echart_Smart_Common *esc, Evas_Object *obj,
+                     Evas_Coord w, Evas_Coord h)
+{
+    if ((esc->w == w) && (esc->h == h))
+        return;
+
+    esc->w = w;
+    esc->h = h;
+    esc->need_resize = EINA_TRUE;
+    evas_object_smart_changed(obj);
+}
+
+/* size of the object, or of the chart if the object has not been resized */
+void
+echart_size_get(const Echart_Smart_Common *esc, int *w, int *h)
+{
+    if ((esc->w > 0) && (esc->h > 0))
+    {
+        *w = esc->w;
+        *h = esc->h;
+        return;
+    }
+
+    echart_chart_size_get(esc->chart, w, h);
+}
+
+/* the mouse moves on the plot are only recorded, see echart_object_changed() */
+void
+echart_pointer_callbacks_add(Echart_Smart_Common *esc, Evas_Object *obj)
+{
+    evas_object_event_callback_add(esc->vg, EVAS_CALLBACK_MOUSE_MOVE,
+                                   _echart_pointer_move_cb, obj);
+    evas_object_event_callback_add(esc->img, EVAS_CALLBACK_MOUSE_MOVE,
+                                   _echart_pointer_move_cb, obj);
+    evas_object_event_callback_add(esc->vg, EVAS_CALLBACK_MOUSE_OUT,
+                                   _echart_pointer_out_cb, obj);
+    evas_object_event_callback_add(esc->img, EVAS_CALLBACK_MOUSE_OUT,
+                                   _echart_pointer_out_cb, obj);
 }
 
 void
@@ -63,3 +229,340 @@ echart_offsets_get(Evas_Object *title, Echart_Offsets *offsets)
     offsets->top += 10;
     offsets->bottom = 10;
 }
+
+/*
+ * Window of the data displayed: the one set by the user, or the range
+ * of the absciss and the interval of the data, ymax being rounded up.
+ */
+Eina_Bool
+echart_viewport_get(Echart_Smart_Common *esc,
+                    double *xmin, double *xmax,
+                    double *ymin, double *ymax)
+{
+    const Echart_Data *data;
+    const Echart_Serie *absciss;
+    const Eina_Inarray *x_values;
+    double y0;
+    double y1;
+    int gyn;
+
+    data = echart_chart_data_get(esc->chart);
+    absciss = echart_data_absciss_get(data);
+    x_values = echart_serie_values_get(absciss);
+    if (!x_values || !x_values->len)
+        return EINA_FALSE;
+
+    if (esc->viewport.x_set)
+    {
+        *xmin = esc->viewport.xmin;
+        *xmax = esc->viewport.xmax;
+    }
+    else
+    {
+        /* the absciss of a scatter chart are not sorted */
+        echart_serie_interval_get(absciss, xmin, xmax);
+        if (*xmax <= *xmin)
+            *xmax = *xmin + 1;
+    }
+
+    /*
+     * the ordinate goes from tick to tick, the ticks being cached, so
+     * that a mouse move or a relayout does not compute them again
+     */
+    echart_chart_grid_nbr_get(esc->chart, NULL, &gyn);
+    if (esc->viewport.y_set)
+        echart_scale_set(&esc->yscale,
+                         esc->viewport.ymin, esc->viewport.ymax,
+                         gyn, esc->h_vg - 2 * esc->padding, EINA_TRUE);
+    else
+    {
+        echart_data_interval_get(data, &y0, &y1);
+        echart_scale_set(&esc->yscale,
+                         y0, y1,
+                         gyn, esc->h_vg - 2 * esc->padding, EINA_FALSE);
+    }
+    *ymin = esc->yscale.min;
+    *ymax = esc->yscale.max;
+
+    return EINA_TRUE;
+}
+
+void
+echart_viewport_set(Echart_Smart_Common *esc,
+                    double xmin, double xmax,
+                    double ymin, double ymax)
+{
+    if ((xmin >= xmax) || (ymin >= ymax))
+    {
+        ERR("invalid viewport [%g, %g] x [%g, %g]", xmin, xmax, ymin, ymax);
+        return;
+    }
+
+    esc->viewport.xmin = xmin;
+    esc->viewport.xmax = xmax;
+    esc->viewport.ymin = ymin;
+    esc->viewport.ymax = ymax;
+    esc->viewport.x_set = EINA_TRUE;
+    esc->viewport.y_set = EINA_TRUE;
+}
+
+void
+echart_viewport_reset(Echart_Smart_Common *esc)
+{
+    esc->viewport.x_set = EINA_FALSE;
+    esc->viewport.y_set = EINA_FALSE;
+}
+
+void
+echart_viewport_pan(Echart_Smart_Common *esc, double dx, double dy)
+{
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+
+    if (!echart_viewport_get(esc, &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    echart_viewport_set(esc, xmin + dx, xmax + dx, ymin + dy, ymax + dy);
+}
+
+/* zoom in (factor > 1) or out (factor < 1), the point (x, y) being fixed */
+void
+echart_viewport_zoom(Echart_Smart_Common *esc,
+                     double factor, double x, double y)
+{
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+
+    if (factor <= 0)
+        return;
+
+    if (!echart_viewport_get(esc, &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    echart_viewport_set(esc,
+                        x - (x - xmin) / factor, x + (xmax - x) / factor,
+                        y - (y - ymin) / factor, y + (ymax - y) / factor);
+}
+
+/*
+ * Indices [first, last] of the values of v in [min, max], plus one
+ * neighbour on each side so that the segments crossing the borders of
+ * the window are drawn. The whole serie is returned if it is not sorted.
+ */
+void
+echart_viewport_range_get(const double *v, unsigned int len,
+                          Eina_Bool sorted,
+                          double min, double max,
+                          unsigned int *first, unsigned int *last)
+{
+    unsigned int lo;
+    unsigned int hi;
+    unsigned int mid;
+
+    *first = 0;
+    *last = len ? len - 1 : 0;
+    if (!sorted || (len < 3))
+        return;
+
+    /* first index with v >= min */
+    lo = 0;
+    hi = len;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (v[mid] < min)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *first = (lo > 0) ? lo - 1 : 0;
+
+    /* first index with v > max */
+    hi = len;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (v[mid] <= max)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *last = (lo < len) ? lo : len - 1;
+    if (*first > *last)
+        *first = *last;
+}
+
+/*
+ * Cumulated values of the samples [first, last] of the series: the row
+ * k, made of last - first + 1 values, is the sum of the series 0 to k.
+ * Each row is computed in one pass from the previous one, in a buffer
+ * kept from one calculation to the next. A serie without these samples
+ * adds nothing.
+ */
+const double *
+echart_stack_get(Echart_Smart_Common *esc,
+                 const Eina_List *series,
+                 unsigned int first, unsigned int last)
+{
+    const Echart_Serie *serie;
+    const Eina_List *l;
+    const double *prev;
+    double *row;
+    size_t size;
+    unsigned int n;
+    unsigned int i;
+
+    n = last - first + 1;
+    size = eina_list_count(series) * n;
+    if (!size)
+        return NULL;
+
+    if (size > esc->stack_size)
+    {
+        double *stack;
+
+        stack = (double *)realloc(esc->stack, size * sizeof(double));
+        if (!stack)
+        {
+            ERR("Could not allocate the stacked series.");
+            return NULL;
+        }
+        esc->stack = stack;
+        esc->stack_size = size;
+    }
+
+    prev = NULL;
+    row = esc->stack;
+    EINA_LIST_FOREACH(series, l, serie)
+    {
+        const Eina_Inarray *y_values;
+        const double *yv;
+
+        y_values = echart_serie_values_get(serie);
+        if (y_values->len <= last)
+        {
+            if (prev)
+                memcpy(row, prev, n * sizeof(double));
+            else
+                memset(row, 0, n * sizeof(double));
+        }
+        else
+        {
+            yv = (const double *)y_values->members + first;
+            if (prev)
+            {
+                for (i = 0; i < n; i++)
+                    row[i] = prev[i] + yv[i];
+            }
+            else
+                memcpy(row, yv, n * sizeof(double));
+        }
+        prev = row;
+        row += n;
+    }
+
+    return esc->stack;
+}
+
+/*
+ * Text object i of the labels of an axis, created if needed, i being at
+ * most the number of objects. They are reused from one calculation to
+ * the next one.
+ */
+Evas_Object *
+echart_label_object_get(Eina_Inarray *labels, Evas_Object *obj,
+                        unsigned int i)
+{
+    Evas_Object *o;
+
+    if (i < eina_inarray_count(labels))
+        return *(Evas_Object **)eina_inarray_nth(labels, i);
+
+    o = evas_object_text_add(evas_object_evas_get(obj));
+    if (evas_object_clip_get(obj))
+        evas_object_clip_set(o, evas_object_clip_get(obj));
+    if (evas_object_visible_get(obj))
+        evas_object_show(o);
+    eina_inarray_push(labels, &o);
+
+    return o;
+}
+
+/* delete the text objects of the labels after the nbr first ones */
+void
+echart_labels_count_set(Eina_Inarray *labels, unsigned int nbr)
+{
+    while (eina_inarray_count(labels) > nbr)
+    {
+        Evas_Object **t;
+
+        t = eina_inarray_pop(labels);
+        evas_object_del(*t);
+    }
+}
+
+/*
+ * Stride between the labels [first, last] of an axis, spacing pixels
+ * apart, so that they do not overlap. Their extent is the largest one
+ * of a few of them, evenly spread, measured once with the text cache.
+ * The number of labels drawn then depends on the length of the axis,
+ * not on the number of labels.
+ */
+unsigned int
+echart_labels_stride_get(Eina_Inarray *labels, Evas_Object *obj,
+                         const Echart_Font_Style *fs,
+                         Echart_Label_Text_Cb text_cb,
+                         const void *data,
+                         unsigned int first, unsigned int last,
+                         double spacing, Eina_Bool vertical)
+{
+    Evas_Object *probe;
+    double stride;
+    unsigned int nbr;
+    unsigned int k;
+    Evas_Coord extent;
+
+    if (last < first)
+        return 1;
+
+    nbr = last - first + 1;
+    probe = NULL;
+    extent = 0;
+    for (k = 0; k < ECHART_LABELS_SAMPLES; k++)
+    {
+        char buf[128];
+        Evas_Coord w;
+        Evas_Coord h;
+        unsigned int i;
+
+        i = first + (unsigned int)((double)k * (nbr - 1) / (ECHART_LABELS_SAMPLES - 1));
+        text_cb(data, i, buf, sizeof(buf));
+        if (!echart_text_size_get(buf, fs, &w, &h))
+        {
+            if (!probe)
+                probe = echart_label_object_get(labels, obj, 0);
+            echart_text_object_set(probe, buf, fs, &w, &h);
+        }
+        if (vertical && (h > extent))
+            extent = h;
+        if (!vertical && (w > extent))
+            extent = w;
+        if (nbr == 1)
+            break;
+    }
+
+    if (spacing <= 0)
+        return nbr;
+
+    stride = ceil((extent + ECHART_LABELS_GAP) / spacing);
+    if (stride < 1)
+        stride = 1;
+    if (stride > nbr)
+        stride = nbr;
+
+    return (unsigned int)stride;
+}
@@ -22,6 +22,9 @@
 #include <Eina.h>
 #include <Evas.h>
 
+#include "echart_scale.h"
+#include "echart_stats.h"
+
 #define COL_TO_A(col_) (((col_) >> 24) & 0xff)
 #define COL_TO_R(col_) (((col_) >> 16) & 0xff)
 #define COL_TO_G(col_) (((col_) >> 8 ) & 0xff)
@@ -30,6 +33,17 @@
 #define PAD(v_) (sd->common.padding + (v_))
 #define PAD2(v_) (2 * sd->common.padding + (v_))
 
+/* window of the data displayed, the data range is used when not set */
+typedef struct
+{
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    Eina_Bool x_set : 1;
+    Eina_Bool y_set : 1;
+} Echart_Viewport;
+
 typedef struct
 {
     EINA_REFCOUNT;
@@ -40,11 +54,33 @@ typedef struct
     Evas_Object *title;
     Evas_Object *vg;
     Efl_VG *root;
+    Evas_Object *img;
+    Evas_Object *overlay; /* interaction feedback, see echart_overlay_add() */
+    Efl_VG *overlay_root;
+    Echart_Backend backend;
+    Echart_Viewport viewport;
+    Echart_Scale yscale; /* ticks of the ordinate, see echart_viewport_get() */
+    Evas_Coord bottom; /* under the plot, for the labels of the absciss */
+    double *stack; /* cumulated series, see echart_stack_get() */
+    size_t stack_size;
     Evas_Coord w_vg;
     Evas_Coord h_vg;
     Evas_Coord padding;
+    Evas_Coord w; /* size of the object, see echart_size_get() */
+    Evas_Coord h;
+    Evas_Coord pointer_x; /* last position of the mouse on the plot */
+    Evas_Coord pointer_y;
+    Eina_Bool pointer_in : 1;
+    Eina_Bool pointer_changed : 1; /* not handled yet, see echart_object_changed() */
+    Eina_Bool need_layout : 1;
+    Eina_Bool need_resize : 1; /* only the size has changed */
+    Echart_Stats_Recorder stats;
 } Echart_Smart_Common;
 
+/* text of the label i of an axis */
+typedef void (*Echart_Label_Text_Cb)(const void *data, unsigned int i,
+                                     char *buf, size_t size);
+
 typedef struct
 {
     Evas_Coord left;
@@ -58,6 +94,58 @@ void echart_background_set(Echart_Smart_Common *esc,
 
 void echart_vg_set(Echart_Smart_Common *esc);
 
+void echart_backend_set(Echart_Smart_Common *esc, Eina_Bool visible);
+
+void echart_vg_reset(Echart_Smart_Common *esc);
+
+void echart_overlay_add(Echart_Smart_Common *esc, Evas *evas);
+
+void echart_object_changed(Echart_Smart_Common *esc, Evas_Object *obj,
+                           Eina_Bool layout);
+
+void echart_pointer_callbacks_add(Echart_Smart_Common *esc, Evas_Object *obj);
+
+void echart_object_resize(Echart_Smart_Common *esc, Evas_Object *obj,
+                          Evas_Coord w, Evas_Coord h);
+
+void echart_size_get(const Echart_Smart_Common *esc, int *w, int *h);
+
 void echart_offsets_get(Evas_Object *title, Echart_Offsets *offsets);
 
+Eina_Bool echart_viewport_get(Echart_Smart_Common *esc,
+                              double *xmin, double *xmax,
+                              double *ymin, double *ymax);
+
+void echart_viewport_set(Echart_Smart_Common *esc,
+                         double xmin, double xmax,
+                         double ymin, double ymax);
+
+void echart_viewport_reset(Echart_Smart_Common *esc);
+
+void echart_viewport_pan(Echart_Smart_Common *esc, double dx, double dy);
+
+void echart_viewport_zoom(Echart_Smart_Common *esc,
+                          double factor, double x, double y);
+
+void echart_viewport_range_get(const double *v, unsigned int len,
+                               Eina_Bool sorted,
+                               double min, double max,
+                               unsigned int *first, unsigned int *last);
+
+const double *echart_stack_get(Echart_Smart_Common *esc,
+                               const Eina_List *series,
+                               unsigned int first, unsigned int last);
+
+Evas_Object *echart_label_object_get(Eina_Inarray *labels, Evas_Object *obj,
+                                     unsigned int i);
+
+void echart_labels_count_set(Eina_Inarray *labels, unsigned int nbr);
+
+unsigned int echart_labels_stride_get(Eina_Inarray *labels, Evas_Object *obj,
+                                      const Echart_Font_Style *fs,
+                                      Echart_Label_Text_Cb text_cb,
+                                      const void *data,
+                                      unsigned int first, unsigned int last,
+                                      double spacing, Eina_Bool vertical);
+
 #endif /* ECHART_COMMON_H */
@@ -0,0 +1,1128 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <float.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_text.h"
+#include "echart_raster.h"
+#include "echart_line.h"
+#include "echart_lod.h"
+#include "echart_dashboard.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_DASHBOARD_SMART_OBJ_GET(smart, o, type) \
+{ \
+    char *_echart_dashboard_smart_str; \
+    if (!o) return; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) return; \
+    _echart_dashboard_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_dashboard_smart_str) return; \
+    if (strcmp(_echart_dashboard_smart_str, type)) return; \
+}
+
+#define ECHART_DASHBOARD_SMART_OBJ_GET_ERROR(smart, o, type) \
+{ \
+    char *_echart_dashboard_smart_str; \
+    if (!o) goto _err; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) goto _err; \
+    _echart_dashboard_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_dashboard_smart_str) goto _err; \
+    if (strcmp(_echart_dashboard_smart_str, type)) goto _err; \
+}
+
+#define ECHART_DASHBOARD_OBJ_NAME "echart_dashboard_object"
+
+/*
+ * All the panels are drawn in the VG object (one shape for the axes of
+ * all the panels, one for their grids, one per serie) or in the image
+ * of the common part, so that the number of Evas objects does not
+ * depend on the number of panels. Only the optional titles of the
+ * panels are text objects, reused from one calculation to the next.
+ */
+typedef struct
+{
+    Echart_Data *data;
+    Echart_Scale yscale; /* when the scale is not shared */
+    /* lines of the last layout, see _echart_dashboard_resize_update() */
+    Efl_VG *lines; /* container of the lines, in the VG backend */
+    Echart_Raster_Transform t; /* transform they were drawn with */
+    double xmin;
+    double xmax;
+    unsigned int part; /* first part of the buffers */
+    unsigned int nbr_parts;
+} Echart_Dashboard_Panel;
+
+/* samples of a line kept in its part of the buffers */
+typedef struct
+{
+    unsigned int nbr;
+    unsigned int color;
+    Eina_Bool sorted;
+} Echart_Dashboard_Part;
+
+typedef struct
+{
+    Echart_Smart_Common common; /* common.yscale is the shared scale */
+    Eina_Inarray *panels;
+    Eina_Inarray *titles; /* text objects of the titles of the panels */
+    double *lod_x; /* decimated samples, a part per serie */
+    double *lod_y;
+    unsigned int lod_size;
+    Echart_Dashboard_Part *parts;
+    unsigned int parts_size;
+    unsigned int lod_columns; /* columns of a part of the buffers */
+    Efl_VG *frames; /* axes of all the panels, in the VG backend */
+    Efl_VG *grid;
+    unsigned int columns; /* 0 for a square grid */
+    Eina_Bool shared_scale;
+    Eina_Bool titles_visible;
+    Eina_Bool built; /* the lines of the last layout can be reused */
+} Echart_Smart_Data;
+
+/* samples [first, last] of a serie, as they are drawn */
+typedef struct
+{
+    const double *xv;
+    const double *yv;
+    unsigned int first;
+    unsigned int last;
+} Echart_Dashboard_Points;
+
+static Evas_Smart *_echart_dashboard_smart = NULL;
+
+static void
+_echart_dashboard_panels_free(Echart_Smart_Data *sd)
+{
+    Echart_Dashboard_Panel *panel;
+
+    EINA_INARRAY_FOREACH(sd->panels, panel)
+        echart_data_free(panel->data);
+    eina_inarray_flush(sd->panels);
+}
+
+static void
+_echart_dashboard_smart_add(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = calloc(1, sizeof(Echart_Smart_Data));
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_INIT((Echart_Smart_Common *)sd);
+
+    sd->common.bg = evas_object_rectangle_add(evas_object_evas_get(obj));
+    evas_object_move(sd->common.bg, 0, 0);
+    sd->common.title = evas_object_text_add(evas_object_evas_get(obj));
+    sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
+    sd->common.root = evas_vg_container_add(sd->common.vg);
+    evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+    sd->panels = eina_inarray_new(sizeof(Echart_Dashboard_Panel), 0);
+    sd->titles = eina_inarray_new(sizeof(Evas_Object *), 0);
+
+    sd->common.need_layout = EINA_TRUE;
+
+    evas_object_smart_data_set(obj, sd);
+}
+
+static void
+_echart_dashboard_smart_del(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
+    {
+        Evas_Object **t;
+
+        _echart_dashboard_panels_free(sd);
+        eina_inarray_free(sd->panels);
+        EINA_INARRAY_FOREACH(sd->titles, t)
+            evas_object_del(*t);
+        eina_inarray_free(sd->titles);
+        free(sd->lod_x);
+        free(sd->lod_y);
+        free(sd->parts);
+        evas_object_del(sd->common.bg);
+        evas_object_del(sd->common.title);
+        evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        free(sd);
+    }
+}
+
+static void
+_echart_dashboard_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+    Echart_Smart_Data *sd;
+    Evas_Object **t;
+    Evas_Coord ox;
+    Evas_Coord oy;
+    Evas_Coord dx;
+    Evas_Coord dy;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_geometry_get(obj, &ox, &oy, NULL, NULL);
+    dx = x - ox;
+    dy = y - oy;
+
+    evas_object_geometry_get(sd->common.bg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.bg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.title, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.title, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.vg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.vg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+    EINA_INARRAY_FOREACH(sd->titles, t)
+    {
+        evas_object_geometry_get(*t, &ox, &oy, NULL, NULL);
+        evas_object_move(*t, ox + dx, oy + dy);
+    }
+}
+
+static void
+_echart_dashboard_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
+}
+
+static void
+_echart_dashboard_smart_show(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+    Evas_Object **t;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_show(sd->common.bg);
+    evas_object_show(sd->common.title);
+    EINA_INARRAY_FOREACH(sd->titles, t)
+        evas_object_show(*t);
+    echart_backend_set((Echart_Smart_Common *)sd, EINA_TRUE);
+}
+
+static void
+_echart_dashboard_smart_hide(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+    Evas_Object **t;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_hide(sd->common.bg);
+    evas_object_hide(sd->common.title);
+    EINA_INARRAY_FOREACH(sd->titles, t)
+        evas_object_hide(*t);
+    evas_object_hide(sd->common.vg);
+    evas_object_hide(sd->common.img);
+}
+
+static void
+_echart_dashboard_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+    Echart_Smart_Data *sd;
+    Evas_Object **t;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_set(sd->common.bg, clip);
+    evas_object_clip_set(sd->common.title, clip);
+    EINA_INARRAY_FOREACH(sd->titles, t)
+        evas_object_clip_set(*t, clip);
+    evas_object_clip_set(sd->common.vg, clip);
+    evas_object_clip_set(sd->common.img, clip);
+}
+
+static void
+_echart_dashboard_smart_clip_unset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+    Evas_Object **t;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_unset(sd->common.bg);
+    evas_object_clip_unset(sd->common.title);
+    EINA_INARRAY_FOREACH(sd->titles, t)
+        evas_object_clip_unset(*t);
+    evas_object_clip_unset(sd->common.vg);
+    evas_object_clip_unset(sd->common.img);
+}
+
+/*
+ * Buffers of the decimated samples: each serie of each panel has its
+ * own part of 4 * (columns + 2) samples, as the raster backend draws
+ * them once all the panels are recorded.
+ */
+static Eina_Bool
+_echart_dashboard_lod_begin(Echart_Smart_Data *sd,
+                            unsigned int nbr_series, unsigned int columns)
+{
+    unsigned int size;
+
+    sd->lod_columns = columns;
+    size = nbr_series * 4 * (columns + 2);
+    if (size > sd->lod_size)
+    {
+        double *lod_x;
+        double *lod_y;
+
+        lod_x = (double *)realloc(sd->lod_x, size * sizeof(double));
+        if (!lod_x)
+            return EINA_FALSE;
+        sd->lod_x = lod_x;
+        lod_y = (double *)realloc(sd->lod_y, size * sizeof(double));
+        if (!lod_y)
+            return EINA_FALSE;
+        sd->lod_y = lod_y;
+        sd->lod_size = size;
+    }
+
+    if (nbr_series > sd->parts_size)
+    {
+        Echart_Dashboard_Part *parts;
+
+        parts = (Echart_Dashboard_Part *)realloc(sd->parts, nbr_series * sizeof(Echart_Dashboard_Part));
+        if (!parts)
+            return EINA_FALSE;
+        sd->parts = parts;
+        sd->parts_size = nbr_series;
+    }
+
+    return EINA_TRUE;
+}
+
+/*
+ * Fill p with the samples of a serie to draw in columns pixels,
+ * decimated in the part idx of the buffers when there are more samples
+ * than pixels. The decimation needs a sorted absciss.
+ */
+static void
+_echart_dashboard_lod_apply(Echart_Smart_Data *sd,
+                            unsigned int idx,
+                            const double *xv, const double *yv,
+                            unsigned int first, unsigned int last,
+                            Eina_Bool sorted,
+                            double xmin, double xmax,
+                            unsigned int columns,
+                            Echart_Dashboard_Points *p)
+{
+    Echart_Lod lod;
+    unsigned int size;
+    unsigned int n;
+    double *lod_x;
+    double *lod_y;
+
+    p->xv = xv;
+    p->yv = yv;
+    p->first = first;
+    p->last = last;
+
+    size = 4 * (columns + 2);
+    if (!sorted || (sd->lod_size < (idx + 1) * size))
+        return;
+
+    lod = echart_lod_select(ECHART_LOD_RAW, last - first + 1, columns);
+    if (lod == ECHART_LOD_RAW)
+        return;
+
+    lod_x = sd->lod_x + idx * size;
+    lod_y = sd->lod_y + idx * size;
+    if (lod == ECHART_LOD_DOWNSAMPLE)
+        n = echart_lod_downsample(xv, yv, first, last, columns,
+                                  lod_x, lod_y);
+    else
+        n = echart_lod_envelope(xv, yv, first, last, xmin, xmax, columns,
+                                lod_x, lod_y);
+    if (!n)
+        return;
+
+    p->xv = lod_x;
+    p->yv = lod_y;
+    p->first = 0;
+    p->last = n - 1;
+}
+
+/*
+ * Keep the samples p of the line in the part idx of the buffers, for
+ * the raster backend to draw them again on a resize. Returns EINA_FALSE
+ * if they do not fit.
+ */
+static Eina_Bool
+_echart_dashboard_part_set(Echart_Smart_Data *sd, unsigned int idx,
+                           const Echart_Dashboard_Points *p,
+                           Eina_Bool sorted, unsigned int color)
+{
+    Echart_Dashboard_Part *part;
+    unsigned int size;
+    unsigned int n;
+    double *lod_x;
+    double *lod_y;
+
+    size = 4 * (sd->lod_columns + 2);
+    n = p->last - p->first + 1;
+    if ((idx >= sd->parts_size) || (sd->lod_size < (idx + 1) * size) ||
+        (n > size))
+        return EINA_FALSE;
+
+    lod_x = sd->lod_x + idx * size;
+    lod_y = sd->lod_y + idx * size;
+    /* the samples that are not decimated are copied */
+    if (p->xv != lod_x)
+    {
+        memcpy(lod_x, p->xv + p->first, n * sizeof(double));
+        memcpy(lod_y, p->yv + p->first, n * sizeof(double));
+    }
+
+    part = sd->parts + idx;
+    part->nbr = n;
+    part->color = color;
+    part->sorted = sorted;
+
+    return EINA_TRUE;
+}
+
+/*
+ * Axis and grid of a panel in the rectangle (x0, y0, pw, ph) of the VG
+ * object or of the raster r: the axes are appended to the shape frames
+ * and the grid lines to the shape grid, so that they are shared by all
+ * the panels.
+ */
+static void
+_echart_dashboard_frame_draw(Echart_Smart_Data *sd,
+                             const Echart_Scale *scale,
+                             Echart_Raster *r,
+                             Efl_VG *frames, Efl_VG *grid,
+                             double x0, double y0,
+                             unsigned int pw, unsigned int ph,
+                             int gyn)
+{
+    unsigned int col;
+    unsigned int i;
+
+    /* axis */
+    if (r)
+    {
+        echart_raster_rect_fill(r, x0, y0, x0 + 1, y0 + ph, 0xff000000);
+        echart_raster_rect_fill(r, x0, y0 + ph - 1, x0 + pw, y0 + ph,
+                                0xff000000);
+    }
+    else
+    {
+        evas_vg_shape_append_move_to(frames, x0 + 0.5, y0 + 0.5);
+        evas_vg_shape_append_line_to(frames, x0 + 0.5, y0 + ph - 0.5);
+        evas_vg_shape_append_line_to(frames, x0 + pw - 0.5, y0 + ph - 0.5);
+    }
+
+    /* grid, on the ticks of the scale */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    if (gyn > 0)
+    {
+        for (i = 1; i <= scale->nbr; i++)
+        {
+            int j;
+
+            j = (scale->max - echart_scale_tick_get(scale, i)) * (ph - 1) / (scale->max - scale->min);
+            if (r)
+                echart_raster_rect_fill(r,
+                                        x0 + 1, y0 + j,
+                                        x0 + pw, y0 + j + 1,
+                                        col);
+            else
+            {
+                evas_vg_shape_append_move_to(grid, x0 + 1, y0 + j + 0.5);
+                evas_vg_shape_append_line_to(grid, x0 + pw - 0.5, y0 + j + 0.5);
+            }
+        }
+    }
+}
+
+/*
+ * Draw the panel in the rectangle (x0, y0, pw, ph) of the VG object or
+ * of the raster r. part is the next part of the buffers of the
+ * decimated samples.
+ */
+static void
+_echart_dashboard_panel_draw(Echart_Smart_Data *sd,
+                             Echart_Dashboard_Panel *panel,
+                             Echart_Raster *r,
+                             double x0, double y0,
+                             unsigned int pw, unsigned int ph,
+                             int gyn, unsigned int *part)
+{
+    const Echart_Scale *scale;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_Inarray *x_values;
+    const Eina_List *l;
+    const double *xv;
+    unsigned int i;
+    Eina_Bool sorted;
+
+    scale = sd->shared_scale ? &sd->common.yscale : &panel->yscale;
+    _echart_dashboard_frame_draw(sd, scale, r, sd->frames, sd->grid,
+                                 x0, y0, pw, ph, gyn);
+
+    panel->part = *part;
+    panel->nbr_parts = 0;
+
+    /* lines */
+    absciss = echart_data_absciss_get(panel->data);
+    x_values = echart_serie_values_get(absciss);
+    if (!x_values || !x_values->len)
+        return;
+
+    xv = (const double *)x_values->members;
+    sorted = echart_serie_sorted_get(absciss);
+    echart_serie_interval_get(absciss, &panel->xmin, &panel->xmax);
+    if (panel->xmax <= panel->xmin)
+        panel->xmax = panel->xmin + 1;
+
+    /* the same transform for both backends */
+    echart_raster_transform_set(&panel->t,
+                                panel->xmin, panel->xmax,
+                                scale->min, scale->max,
+                                x0, y0,
+                                pw - 1, ph - 1);
+
+    if (!r)
+        panel->lines = evas_vg_container_add(sd->common.root);
+
+    EINA_LIST_FOREACH(echart_data_series_get(panel->data), l, serie)
+    {
+        const Echart_Raster_Transform *t;
+        const Eina_Inarray *y_values;
+        Echart_Dashboard_Points p;
+        Echart_Colors cols;
+        Efl_VG *line;
+
+        y_values = echart_serie_values_get(serie);
+        if (y_values->len < x_values->len)
+            continue;
+        cols = echart_serie_color_get(serie);
+
+        _echart_dashboard_lod_apply(sd, *part,
+                                    xv, (const double *)y_values->members,
+                                    0, x_values->len - 1, sorted,
+                                    panel->xmin, panel->xmax, pw, &p);
+
+        t = &panel->t;
+        if (r)
+        {
+            if (!_echart_dashboard_part_set(sd, *part, &p, sorted, cols.line))
+                sd->built = EINA_FALSE;
+            (*part)++;
+            panel->nbr_parts++;
+            echart_raster_polyline(r, t, p.xv, p.yv, p.first, p.last, sorted,
+                                   1, cols.line);
+            continue;
+        }
+        (*part)++;
+
+        line = evas_vg_shape_add(panel->lines);
+        evas_vg_shape_append_move_to(line,
+                                     t->ax * p.xv[p.first] + t->bx,
+                                     t->ay * p.yv[p.first] + t->by);
+        for (i = p.first + 1; i <= p.last; i++)
+            evas_vg_shape_append_line_to(line,
+                                         t->ax * p.xv[i] + t->bx,
+                                         t->ay * p.yv[i] + t->by);
+        evas_vg_shape_stroke_width_set(line, 1);
+        evas_vg_shape_stroke_color_set(line,
+                                       COL_TO_R(cols.line),
+                                       COL_TO_G(cols.line),
+                                       COL_TO_B(cols.line),
+                                       COL_TO_A(cols.line));
+    }
+}
+
+/*
+ * Titles of the panels, on the top of their cell. They use the same
+ * font, so the height of the first one is the one of all of them.
+ */
+static Evas_Coord
+_echart_dashboard_titles_set(Echart_Smart_Data *sd, Evas_Object *obj,
+                             unsigned int columns,
+                             double cell_w, double cell_h)
+{
+    Echart_Dashboard_Panel *panel;
+    Echart_Font_Style fs;
+    Echart_Offsets offsets;
+    Evas_Coord h_title;
+    unsigned int i;
+
+    if (!sd->titles_visible)
+    {
+        echart_labels_count_set(sd->titles, 0);
+        return 0;
+    }
+
+    echart_offsets_get(sd->common.title, &offsets);
+    echart_chart_title_haxis_style_get(sd->common.chart, &fs);
+
+    h_title = 0;
+    i = 0;
+    EINA_INARRAY_FOREACH(sd->panels, panel)
+    {
+        const char *title;
+        Evas_Object *o;
+
+        title = echart_data_title_get(panel->data);
+        o = echart_label_object_get(sd->titles, obj, i);
+        echart_text_object_set(o, title ? title : "", &fs,
+                               NULL, i ? NULL : &h_title);
+        evas_object_move(o,
+                         offsets.left + (i % columns) * cell_w + PAD(0),
+                         offsets.top + (i / columns) * cell_h);
+        i++;
+    }
+
+    echart_labels_count_set(sd->titles, i);
+
+    return h_title;
+}
+
+/*
+ * Background, title, cells and titles of the panels at the size of the
+ * object, common to a layout and to a resize.
+ */
+static void
+_echart_dashboard_cells_set(Evas_Object *obj, Echart_Smart_Data *sd,
+                            unsigned int *columns,
+                            double *cell_w, double *cell_h,
+                            int *pw, int *ph)
+{
+    Evas_Coord h_title;
+    unsigned int nbr;
+    unsigned int rows;
+    unsigned int col;
+    int w;
+    int h;
+
+    sd->common.padding = 5;
+
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
+    col = echart_chart_background_color_get(sd->common.chart);
+
+    /* background */
+    echart_background_set((Echart_Smart_Common *)sd, w, h, col);
+
+    /* title */
+    if (echart_chart_title_get(sd->common.chart))
+    {
+        Echart_Font_Style fs;
+        Evas_Coord w_title;
+
+        echart_chart_title_style_get(sd->common.chart, &fs);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
+        evas_object_move(sd->common.title, (w - w_title) / 2, 0);
+    }
+
+    /* vg */
+    echart_vg_set((Echart_Smart_Common *)sd);
+
+    /* grid of the panels, as square as possible by default */
+    nbr = eina_inarray_count(sd->panels);
+    *columns = sd->columns;
+    if (!*columns)
+    {
+        *columns = 1;
+        while (*columns * *columns < nbr)
+            (*columns)++;
+    }
+    if (*columns > nbr)
+        *columns = nbr;
+    rows = *columns ? (nbr + *columns - 1) / *columns : 0;
+
+    *cell_w = *columns ? (double)sd->common.w_vg / *columns : 0;
+    *cell_h = rows ? (double)sd->common.h_vg / rows : 0;
+    h_title = _echart_dashboard_titles_set(sd, obj, *columns, *cell_w, *cell_h);
+
+    *pw = *cell_w - PAD2(0);
+    *ph = *cell_h - PAD2(h_title);
+}
+
+/*
+ * Scales of the panels for plots ph pixels high, computed again only
+ * when the ranges or the size change. Returns the number of series.
+ */
+static unsigned int
+_echart_dashboard_scales_set(Echart_Smart_Data *sd, int gyn, int ph)
+{
+    Echart_Dashboard_Panel *panel;
+    unsigned int nbr_series;
+
+    nbr_series = 0;
+    if (sd->shared_scale)
+    {
+        double ymin;
+        double ymax;
+
+        ymin = DBL_MAX;
+        ymax = -DBL_MAX;
+        EINA_INARRAY_FOREACH(sd->panels, panel)
+        {
+            double y0;
+            double y1;
+
+            echart_data_interval_get(panel->data, &y0, &y1);
+            if (y0 < ymin) ymin = y0;
+            if (y1 > ymax) ymax = y1;
+            nbr_series += eina_list_count(echart_data_series_get(panel->data));
+        }
+        echart_scale_set(&sd->common.yscale, ymin, ymax, gyn, ph, EINA_FALSE);
+    }
+    else
+    {
+        EINA_INARRAY_FOREACH(sd->panels, panel)
+        {
+            double y0;
+            double y1;
+
+            echart_data_interval_get(panel->data, &y0, &y1);
+            echart_scale_set(&panel->yscale, y0, y1, gyn, ph, EINA_FALSE);
+            nbr_series += eina_list_count(echart_data_series_get(panel->data));
+        }
+    }
+
+    return nbr_series;
+}
+
+static void
+_echart_dashboard_layout_update(Evas_Object *obj, Echart_Smart_Data *sd)
+{
+    Echart_Dashboard_Panel *panel;
+    Echart_Raster r;
+    Evas_Coord h_title;
+    unsigned int nbr_series;
+    unsigned int columns;
+    unsigned int part;
+    unsigned int col;
+    unsigned int i;
+    double cell_w;
+    double cell_h;
+    int pw;
+    int ph;
+    int gyn;
+    Eina_Bool raster;
+
+    _echart_dashboard_cells_set(obj, sd, &columns, &cell_w, &cell_h, &pw, &ph);
+    h_title = cell_h - ph - PAD2(0);
+
+    echart_backend_set((Echart_Smart_Common *)sd, evas_object_visible_get(obj));
+    echart_vg_reset((Echart_Smart_Common *)sd);
+    sd->frames = NULL;
+    sd->grid = NULL;
+    sd->built = EINA_FALSE;
+    EINA_INARRAY_FOREACH(sd->panels, panel)
+    {
+        panel->lines = NULL;
+        panel->nbr_parts = 0;
+    }
+    raster = sd->common.backend == ECHART_BACKEND_RASTER;
+
+    if (raster)
+    {
+        if (!echart_raster_begin(&r, sd->common.img,
+                                 sd->common.w_vg, sd->common.h_vg))
+            return;
+
+        echart_raster_clear(&r, 0x00000000);
+    }
+
+    if (!columns || (pw < 2) || (ph < 2))
+        goto end;
+
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    nbr_series = _echart_dashboard_scales_set(sd, gyn, ph);
+    sd->built = _echart_dashboard_lod_begin(sd, nbr_series, pw);
+
+    if (!raster)
+    {
+        sd->frames = evas_vg_shape_add(sd->common.root);
+        sd->grid = evas_vg_shape_add(sd->common.root);
+    }
+
+    i = 0;
+    part = 0;
+    EINA_INARRAY_FOREACH(sd->panels, panel)
+    {
+        _echart_dashboard_panel_draw(sd, panel, raster ? &r : NULL,
+                                     (i % columns) * cell_w + PAD(0),
+                                     (i / columns) * cell_h + PAD(h_title),
+                                     pw, ph, gyn, &part);
+        i++;
+    }
+
+    if (!raster)
+    {
+        col = echart_chart_grid_color_get(sd->common.chart);
+        evas_vg_shape_stroke_width_set(sd->frames, 1);
+        evas_vg_shape_stroke_color_set(sd->frames, 0, 0, 0, 255);
+        evas_vg_shape_stroke_width_set(sd->grid, 1);
+        evas_vg_shape_stroke_color_set(sd->grid,
+                                       COL_TO_R(col), COL_TO_G(col), COL_TO_B(col), COL_TO_A(col));
+    }
+
+  end:
+    if (raster)
+        echart_raster_end(&r, sd->common.img);
+}
+
+/*
+ * Frame with only a resize: the cells, the axes and the grids follow
+ * the new size, and the lines of the last layout are reused, without
+ * walking the data. The VG backend moves and scales the container of
+ * the lines of each panel, the raster backend draws again the samples
+ * kept in the buffers. Like the line object, the decimated samples are
+ * kept while the width stays between 1/2 and 5/4 of the one they were
+ * decimated for. Returns EINA_FALSE if a full layout is needed.
+ */
+static Eina_Bool
+_echart_dashboard_resize_update(Evas_Object *obj, Echart_Smart_Data *sd)
+{
+    Echart_Dashboard_Panel *panel;
+    Echart_Raster r;
+    Evas_Coord h_title;
+    unsigned int columns;
+    unsigned int i;
+    unsigned int k;
+    double cell_w;
+    double cell_h;
+    int pw;
+    int ph;
+    int gyn;
+    Eina_Bool raster;
+
+    if (!sd->built ||
+        (echart_chart_backend_get(sd->common.chart) != sd->common.backend))
+        return EINA_FALSE;
+
+    _echart_dashboard_cells_set(obj, sd, &columns, &cell_w, &cell_h, &pw, &ph);
+    h_title = cell_h - ph - PAD2(0);
+    if (!columns || (pw < 2) || (ph < 2) ||
+        (2 * (unsigned int)pw < sd->lod_columns) ||
+        (4 * (unsigned int)pw > 5 * sd->lod_columns))
+        return EINA_FALSE;
+
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    _echart_dashboard_scales_set(sd, gyn, ph);
+
+    raster = sd->common.backend == ECHART_BACKEND_RASTER;
+    if (raster)
+    {
+        if (!echart_raster_begin(&r, sd->common.img,
+                                 sd->common.w_vg, sd->common.h_vg))
+            return EINA_TRUE;
+
+        echart_raster_clear(&r, 0x00000000);
+    }
+    else
+    {
+        evas_vg_shape_reset(sd->frames);
+        evas_vg_shape_reset(sd->grid);
+    }
+
+    i = 0;
+    EINA_INARRAY_FOREACH(sd->panels, panel)
+    {
+        Echart_Raster_Transform t;
+        const Echart_Scale *scale;
+        double x0;
+        double y0;
+
+        x0 = (i % columns) * cell_w + PAD(0);
+        y0 = (i / columns) * cell_h + PAD(h_title);
+        scale = sd->shared_scale ? &sd->common.yscale : &panel->yscale;
+        _echart_dashboard_frame_draw(sd, scale, raster ? &r : NULL,
+                                     sd->frames, sd->grid,
+                                     x0, y0, pw, ph, gyn);
+        i++;
+
+        if (!panel->lines && !panel->nbr_parts)
+            continue;
+
+        echart_raster_transform_set(&t,
+                                    panel->xmin, panel->xmax,
+                                    scale->min, scale->max,
+                                    x0, y0,
+                                    pw - 1, ph - 1);
+
+        if (raster)
+        {
+            size_t size;
+
+            size = 4 * (sd->lod_columns + 2);
+            for (k = panel->part; k < panel->part + panel->nbr_parts; k++)
+                echart_raster_polyline(&r, &t,
+                                       sd->lod_x + k * size,
+                                       sd->lod_y + k * size,
+                                       0, sd->parts[k].nbr - 1,
+                                       sd->parts[k].sorted,
+                                       1, sd->parts[k].color);
+        }
+        else
+        {
+            Eina_Matrix3 m;
+            double sx;
+            double sy;
+
+            /* from the transform the lines were built with to the new one */
+            sx = t.ax / panel->t.ax;
+            sy = t.ay / panel->t.ay;
+            eina_matrix3_values_set(&m,
+                                    sx, 0, t.bx - sx * panel->t.bx,
+                                    0, sy, t.by - sy * panel->t.by,
+                                    0, 0, 1);
+            evas_vg_node_transformation_set(panel->lines, &m);
+        }
+    }
+
+    if (raster)
+        echart_raster_end(&r, sd->common.img);
+
+    return EINA_TRUE;
+}
+
+static void
+_echart_dashboard_smart_calculate(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    /* called once per frame, all the panels being laid out together */
+    if (sd->common.need_layout || sd->common.need_resize)
+    {
+        /* a resize alone keeps the lines */
+        if (sd->common.need_layout ||
+            !_echart_dashboard_resize_update(obj, sd))
+            _echart_dashboard_layout_update(obj, sd);
+        sd->common.need_layout = EINA_FALSE;
+        sd->common.need_resize = EINA_FALSE;
+    }
+}
+
+static void
+_echart_dashboard_smart_init(void)
+{
+    static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION(ECHART_DASHBOARD_OBJ_NAME);
+
+    if (_echart_dashboard_smart) return;
+
+    if (!sc.add)
+    {
+        sc.add = _echart_dashboard_smart_add;
+        sc.del = _echart_dashboard_smart_del;
+        sc.move = _echart_dashboard_smart_move;
+        sc.resize = _echart_dashboard_smart_resize;
+        sc.show = _echart_dashboard_smart_show;
+        sc.hide = _echart_dashboard_smart_hide;
+        sc.clip_set = _echart_dashboard_smart_clip_set;
+        sc.clip_unset = _echart_dashboard_smart_clip_unset;
+        sc.calculate = _echart_dashboard_smart_calculate;
+    }
+    _echart_dashboard_smart = evas_smart_class_new(&sc);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Evas_Object *
+echart_dashboard_object_add(Evas *evas)
+{
+    Evas_Object *obj;
+
+    _echart_dashboard_smart_init();
+    obj = evas_object_smart_add(evas, _echart_dashboard_smart);
+
+    return obj;
+}
+
+EAPI void
+echart_dashboard_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+    INF("chart set");
+
+    sd->common.chart = chart;
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_dashboard_object_data_append(Evas_Object *obj, Echart_Data *data)
+{
+    Echart_Dashboard_Panel panel;
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    if (!data)
+        return;
+
+    memset(&panel, 0, sizeof(panel));
+    panel.data = data;
+    if (eina_inarray_push(sd->panels, &panel) < 0)
+    {
+        ERR("Could not append the panel.");
+        echart_data_free(data);
+        return;
+    }
+
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_dashboard_object_clear(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    _echart_dashboard_panels_free(sd);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI unsigned int
+echart_dashboard_object_count_get(const Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET_ERROR(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    return eina_inarray_count(sd->panels);
+
+  _err:
+    return 0;
+}
+
+EAPI void
+echart_dashboard_object_columns_set(Evas_Object *obj, unsigned int columns)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    if (sd->columns == columns)
+        return;
+
+    sd->columns = columns;
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_dashboard_object_shared_scale_set(Evas_Object *obj, Eina_Bool shared)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    shared = !!shared;
+    if (sd->shared_scale == shared)
+        return;
+
+    sd->shared_scale = shared;
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_dashboard_object_titles_set(Evas_Object *obj, Eina_Bool titles)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_DASHBOARD_SMART_OBJ_GET(sd, obj, ECHART_DASHBOARD_OBJ_NAME);
+
+    titles = !!titles;
+    if (sd->titles_visible == titles)
+        return;
+
+    sd->titles_visible = titles;
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
@@ -0,0 +1,45 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_DASHBOARD_H
+#define ECHART_DASHBOARD_H
+
+/*
+ * Grid of small line charts (small multiples), laid out and drawn in a
+ * single pass into one VG object or image, whatever the number of
+ * panels. The chart gives the background, the title, the grid and the
+ * backend, each data is a panel.
+ */
+EAPI Evas_Object *echart_dashboard_object_add(Evas *evas);
+EAPI void echart_dashboard_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
+
+/* the dashboard takes over the reference of the caller on data */
+EAPI void echart_dashboard_object_data_append(Evas_Object *obj, Echart_Data *data);
+EAPI void echart_dashboard_object_clear(Evas_Object *obj);
+EAPI unsigned int echart_dashboard_object_count_get(const Evas_Object *obj);
+
+/* 0 (default) for a square grid */
+EAPI void echart_dashboard_object_columns_set(Evas_Object *obj, unsigned int columns);
+
+/* the panels share the ordinate range of all the data (default: EINA_FALSE) */
+EAPI void echart_dashboard_object_shared_scale_set(Evas_Object *obj, Eina_Bool shared);
+
+/* a text object per panel, with the title of its data (default: EINA_FALSE) */
+EAPI void echart_dashboard_object_titles_set(Evas_Object *obj, Eina_Bool titles);
+
+#endif /* ECHART_DASHBOARD_H */
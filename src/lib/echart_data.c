@@ -36,23 +36,36 @@
 
 struct _Echart_Serie
 {
+    EINA_REFCOUNT;
+
     char *title;
     Eina_Inarray *values;
+    unsigned int *order; /* see echart_serie_order_get() */
+    unsigned int order_count; /* values sorted in order */
     Echart_Colors color;
     double ymin;
     double ymax;
     double opacity;
+    Eina_Bool sorted : 1;
 };
 
 struct _Echart_Data
 {
+    EINA_REFCOUNT;
+
     char *title;
     Echart_Serie *absciss;
     Eina_List *series;
     double ymin;
     double ymax;
     double opacity;
+    unsigned int stack_count; /* samples already in the stacked interval */
+    double stack_min;
+    double stack_max;
+    double *stack_sums; /* scratch buffer of _echart_data_stack_update() */
+    unsigned int stack_size;
     Eina_Bool area : 1;
+    Eina_Bool stacked : 1;
 };
 
 static Echart_Colors _echart_chart_colors_default[20] =
@@ -79,6 +92,86 @@ static Echart_Colors _echart_chart_colors_default[20] =
     { 0xff3B3EAC, 0xffc4c5e6 }
 };
 
+/*
+ * Extend the interval of the stacked series with the samples appended
+ * since the last call: the series are summed one after the other on
+ * these samples only, the interval of the previous ones being kept.
+ * Only the samples that all the series have are stacked. The sums are
+ * kept in a buffer of the data, grown when needed.
+ */
+static void
+_echart_data_stack_update(Echart_Data *d)
+{
+    const Echart_Serie *s;
+    const Eina_List *l;
+    double *sums;
+    unsigned int count;
+    unsigned int n;
+    unsigned int i;
+
+    count = d->absciss ? eina_inarray_count(d->absciss->values) : 0;
+    EINA_LIST_FOREACH(d->series, l, s)
+    {
+        if (eina_inarray_count(s->values) < count)
+            count = eina_inarray_count(s->values);
+    }
+    if (count <= d->stack_count)
+        return;
+
+    n = count - d->stack_count;
+    if (n > d->stack_size)
+    {
+        sums = (double *)realloc(d->stack_sums, n * sizeof(double));
+        if (!sums)
+        {
+            ERR("Could not allocate the stacked sums.");
+            return;
+        }
+        d->stack_sums = sums;
+        d->stack_size = n;
+    }
+    sums = d->stack_sums;
+    memset(sums, 0, n * sizeof(double));
+
+    EINA_LIST_FOREACH(d->series, l, s)
+    {
+        const double *yv;
+
+        yv = (const double *)s->values->members + d->stack_count;
+        for (i = 0; i < n; i++)
+            sums[i] += yv[i];
+        for (i = 0; i < n; i++)
+        {
+            if (sums[i] < d->stack_min) d->stack_min = sums[i];
+            if (sums[i] > d->stack_max) d->stack_max = sums[i];
+        }
+    }
+
+    d->stack_count = count;
+}
+
+typedef struct
+{
+    double v;
+    unsigned int i;
+} Echart_Serie_Item;
+
+static int
+_echart_serie_item_cmp(const void *d1, const void *d2)
+{
+    const Echart_Serie_Item *i1;
+    const Echart_Serie_Item *i2;
+
+    i1 = d1;
+    i2 = d2;
+    if (i1->v < i2->v)
+        return -1;
+    if (i1->v > i2->v)
+        return 1;
+    /* stable */
+    return (i1->i < i2->i) ? -1 : (i1->i > i2->i);
+}
+
 /**
  * @endcond
  */
@@ -96,7 +189,9 @@ echart_serie_new(void)
 {
     Echart_Serie *s;
 
-    s = (Echart_Serie *)malloc(sizeof(Echart_Serie));
+    s = (Echart_Serie *)calloc(1, sizeof(Echart_Serie));
+    if (!s)
+        return NULL;
 
     s->values = eina_inarray_new(sizeof(double), 0);
     if (!s->values)
@@ -106,6 +201,19 @@ echart_serie_new(void)
     }
 
     s->opacity = 0.3;
+    s->sorted = EINA_TRUE;
+    EINA_REFCOUNT_INIT(s);
+
+    return s;
+}
+
+EAPI Echart_Serie *
+echart_serie_ref(Echart_Serie *s)
+{
+    if (!s)
+        return NULL;
+
+    EINA_REFCOUNT_REF(s);
 
     return s;
 }
@@ -116,9 +224,13 @@ echart_serie_free(Echart_Serie *s)
     if (!s)
         return;
 
-    eina_inarray_free(s->values);
-    free(s->title);
-    free(s);
+    EINA_REFCOUNT_UNREF(s)
+    {
+        eina_inarray_free(s->values);
+        free(s->order);
+        free(s->title);
+        free(s);
+    }
 }
 
 EAPI void
@@ -174,23 +286,110 @@ echart_serie_value_push(Echart_Serie *s, double y)
     }
     else
     {
+        if (y < ((double *)s->values->members)[s->values->len - 2])
+            s->sorted = EINA_FALSE;
         if (y < s->ymin) s->ymin = y;
         if (y > s->ymax) s->ymax = y;
     }
 }
 
+EAPI Eina_Bool
+echart_serie_sorted_get(const Echart_Serie *s)
+{
+    return s ? s->sorted : EINA_FALSE;
+}
+
 EAPI const Eina_Inarray *
 echart_serie_values_get(const Echart_Serie *s)
 {
     return s ? s->values : NULL;
 }
 
+/*
+ * Indices of the values in increasing order of the values, built at the
+ * first call after values are pushed, and shared by all the charts
+ * displaying the serie. It is NULL if the values are already sorted.
+ */
+EAPI const unsigned int *
+echart_serie_order_get(const Echart_Serie *s)
+{
+    Echart_Serie *serie;
+    Echart_Serie_Item *items;
+    unsigned int *order;
+    unsigned int count;
+    unsigned int i;
+
+    if (!s || s->sorted)
+        return NULL;
+
+    count = eina_inarray_count(s->values);
+    if (s->order && (s->order_count == count))
+        return s->order;
+
+    items = (Echart_Serie_Item *)malloc(count * sizeof(Echart_Serie_Item));
+    if (!items)
+        return NULL;
+
+    order = (unsigned int *)realloc(s->order, count * sizeof(unsigned int));
+    if (!order)
+    {
+        free(items);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        items[i].v = ((const double *)s->values->members)[i];
+        items[i].i = i;
+    }
+    qsort(items, count, sizeof(Echart_Serie_Item), _echart_serie_item_cmp);
+    for (i = 0; i < count; i++)
+        order[i] = items[i].i;
+    free(items);
+
+    /* the order is a cache */
+    serie = (Echart_Serie *)s;
+    serie->order = order;
+    serie->order_count = count;
+
+    return order;
+}
+
+EAPI void
+echart_serie_interval_get(const Echart_Serie *s, double *min, double *max)
+{
+    if (!s || !eina_inarray_count(s->values))
+    {
+        if (min) *min = 0;
+        if (max) *max = 0;
+        return;
+    }
+
+    if (min) *min = s->ymin;
+    if (max) *max = s->ymax;
+}
+
 EAPI Echart_Data *
 echart_data_new(void)
 {
     Echart_Data *d;
 
     d = (Echart_Data *)calloc(1, sizeof(Echart_Data));
+    if (!d)
+        return NULL;
+
+    EINA_REFCOUNT_INIT(d);
+
+    return d;
+}
+
+EAPI Echart_Data *
+echart_data_ref(Echart_Data *d)
+{
+    if (!d)
+        return NULL;
+
+    EINA_REFCOUNT_REF(d);
 
     return d;
 }
@@ -203,11 +402,15 @@ echart_data_free(Echart_Data *d)
     if (!d)
         return;
 
-    EINA_LIST_FREE(d->series, s)
-        echart_serie_free(s);
-    echart_serie_free(d->absciss);
-    free(d->title);
-    free(d);
+    EINA_REFCOUNT_UNREF(d)
+    {
+        EINA_LIST_FREE(d->series, s)
+            echart_serie_free(s);
+        echart_serie_free(d->absciss);
+        free(d->stack_sums);
+        free(d->title);
+        free(d);
+    }
 }
 
 EAPI void
@@ -231,7 +434,14 @@ echart_data_absciss_set(Echart_Data *d, Echart_Serie *s)
     if (!d || !s)
         return;
 
+    /* like echart_chart_data_set(), even if it is the same serie */
+    if (d->absciss)
+        echart_serie_free(d->absciss);
     d->absciss = s;
+    /* the stacked samples are bounded by the count of the absciss */
+    d->stack_count = 0;
+    d->stack_min = 0;
+    d->stack_max = 0;
 }
 
 EAPI const Echart_Serie *
@@ -257,6 +467,10 @@ echart_data_serie_append(Echart_Data *d, Echart_Serie *s)
     count = eina_list_count(d->series);
     s->color = _echart_chart_colors_default[count % 20];
     d->series = eina_list_append(d->series, s);
+    /* the sums of all the samples change */
+    d->stack_count = 0;
+    d->stack_min = 0;
+    d->stack_max = 0;
     if (count == 0)
     {
         d->ymin = s->ymin;
@@ -294,6 +508,15 @@ echart_data_interval_get(const Echart_Data *d, double *ymin, double *ymax)
         return;
     }
 
+    if (d->stacked)
+    {
+        /* the stacked interval is a cache, updated when data are appended */
+        _echart_data_stack_update((Echart_Data *)d);
+        if (ymin) *ymin = (d->stack_min < d->ymin) ? d->stack_min : d->ymin;
+        if (ymax) *ymax = (d->stack_max > d->ymax) ? d->stack_max : d->ymax;
+        return;
+    }
+
     if (ymin) *ymin = d->ymin;
     if (ymax) *ymax = d->ymax;
 }
@@ -310,3 +533,16 @@ echart_data_area_get(const Echart_Data *d)
 {
     return d ? d->area : EINA_FALSE;
 }
+
+EAPI void
+echart_data_stacked_set(Echart_Data *d, Eina_Bool on)
+{
+    if (d)
+        d->stacked = !!on;
+}
+
+EAPI Eina_Bool
+echart_data_stacked_get(const Echart_Data *d)
+{
+    return d ? d->stacked : EINA_FALSE;
+}
@@ -22,7 +22,19 @@
 typedef struct _Echart_Serie Echart_Serie;
 typedef struct _Echart_Data Echart_Data;
 
+/*
+ * The series and the data are refcounted, so that several data can
+ * share a serie and several charts can share data: the data and the
+ * charts take over the reference of the caller, echart_serie_ref() and
+ * echart_data_ref() add a reference for each other user, and
+ * echart_serie_free() and echart_data_free() release one reference.
+ * Each call of a setter takes over one reference, even when it sets
+ * the data already set: the reference held is then released, so the
+ * caller must own a reference for each call.
+ */
+
 EAPI Echart_Serie *echart_serie_new(void);
+EAPI Echart_Serie *echart_serie_ref(Echart_Serie *s);
 EAPI void echart_serie_free(Echart_Serie *s);
 EAPI void echart_serie_title_set(Echart_Serie *s, const char *title);
 EAPI const char *echart_serie_title_get(const Echart_Serie *s);
@@ -30,9 +42,13 @@ EAPI Echart_Colors echart_serie_color_get(const Echart_Serie *s);
 EAPI void echart_serie_opacity_set(Echart_Serie *s, double opacity);
 EAPI double echart_serie_opacity_get(const Echart_Serie *s);
 EAPI void echart_serie_value_push(Echart_Serie *s, double y);
+EAPI Eina_Bool echart_serie_sorted_get(const Echart_Serie *s);
 EAPI const Eina_Inarray *echart_serie_values_get(const Echart_Serie *s);
+EAPI const unsigned int *echart_serie_order_get(const Echart_Serie *s);
+EAPI void echart_serie_interval_get(const Echart_Serie *s, double *min, double *max);
 
 EAPI Echart_Data *echart_data_new(void);
+EAPI Echart_Data *echart_data_ref(Echart_Data *d);
 EAPI void echart_data_free(Echart_Data *d);
 EAPI void echart_data_title_set(Echart_Data *d, const char *title);
 EAPI const char *echart_data_title_get(const Echart_Data *d);
@@ -44,5 +60,7 @@ EAPI void echart_data_ymin_set(Echart_Data *d, double ymin);
 EAPI void echart_data_interval_get(const Echart_Data *d, double *ymin, double *ymax);
 EAPI void echart_data_area_set(Echart_Data *d, Eina_Bool on);
 EAPI Eina_Bool echart_data_area_get(const Echart_Data *d);
+EAPI void echart_data_stacked_set(Echart_Data *d, Eina_Bool on);
+EAPI Eina_Bool echart_data_stacked_get(const Echart_Data *d);
 
 #endif /* ECHART_DATA_H */
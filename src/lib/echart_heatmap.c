@@ -0,0 +1,656 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_text.h"
+#include "echart_heatmap.h"
+#include "echart_colormap.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_HEATMAP_SMART_OBJ_GET(smart, o, type) \
+{ \
+    char *_echart_heatmap_smart_str; \
+    if (!o) return; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) return; \
+    _echart_heatmap_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_heatmap_smart_str) return; \
+    if (strcmp(_echart_heatmap_smart_str, type)) return; \
+}
+
+#define ECHART_HEATMAP_OBJ_NAME "echart_heatmap_object"
+
+/*
+ * The heatmap is always drawn in the image, whatever the backend. The
+ * pixels of the previous calculation are kept, so when columns are
+ * appended and the mapping of the columns on the image is unchanged,
+ * only the pixel columns of the new ones are quantized and drawn.
+ */
+typedef struct
+{
+    Echart_Smart_Common common;
+    const double *values;
+    double *own; /* copy of the values, NULL for a buffer of the caller */
+    unsigned int own_columns; /* allocated columns of own */
+    unsigned int rows;
+    unsigned int columns;
+    unsigned int columns_max;
+    unsigned char *q; /* LUT indices of the values */
+    unsigned int q_columns; /* allocated columns of q */
+    unsigned int q_done; /* columns quantized and drawn */
+    double min; /* color range set by the user */
+    double max;
+    double data_min; /* interval of the values */
+    double data_max;
+    unsigned int lut[ECHART_COLORMAP_SIZE];
+    Echart_Heatmap_Filter filter;
+    unsigned int capacity; /* columns spanning the image, last draw */
+    Evas_Coord w_img;
+    Evas_Coord h_img;
+    Eina_Bool range_set : 1;
+    Eina_Bool full : 1; /* all the values must be quantized and drawn */
+} Echart_Smart_Data;
+
+static Evas_Smart *_echart_heatmap_smart = NULL;
+
+static void
+_echart_heatmap_smart_add(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = calloc(1, sizeof(Echart_Smart_Data));
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_INIT((Echart_Smart_Common *)sd);
+
+    sd->common.bg = evas_object_rectangle_add(evas_object_evas_get(obj));
+    sd->common.title = evas_object_text_add(evas_object_evas_get(obj));
+    sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
+    sd->common.root = evas_vg_container_add(sd->common.vg);
+    evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+    evas_object_image_colorspace_set(sd->common.img, EVAS_COLORSPACE_ARGB8888);
+    evas_object_image_alpha_set(sd->common.img, EINA_TRUE);
+
+    echart_colormap_lut_set(sd->lut, NULL, 0);
+    sd->filter = ECHART_HEATMAP_FILTER_NEAREST;
+    sd->full = EINA_TRUE;
+
+    evas_object_smart_data_set(obj, sd);
+}
+
+static void
+_echart_heatmap_smart_del(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
+    {
+        free(sd->own);
+        free(sd->q);
+        evas_object_del(sd->common.bg);
+        evas_object_del(sd->common.title);
+        evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        free(sd);
+    }
+}
+
+static void
+_echart_heatmap_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+    Echart_Smart_Data *sd;
+    Evas_Coord ox;
+    Evas_Coord oy;
+    Evas_Coord dx;
+    Evas_Coord dy;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_geometry_get(obj, &ox, &oy, NULL, NULL);
+    dx = x - ox;
+    dy = y - oy;
+
+    evas_object_geometry_get(sd->common.bg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.bg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.title, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.title, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+}
+
+static void
+_echart_heatmap_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
+}
+
+static void
+_echart_heatmap_smart_show(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_show(sd->common.bg);
+    evas_object_show(sd->common.title);
+    evas_object_show(sd->common.img);
+}
+
+static void
+_echart_heatmap_smart_hide(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_hide(sd->common.bg);
+    evas_object_hide(sd->common.title);
+    evas_object_hide(sd->common.img);
+}
+
+static void
+_echart_heatmap_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_set(sd->common.bg, clip);
+    evas_object_clip_set(sd->common.title, clip);
+    evas_object_clip_set(sd->common.img, clip);
+}
+
+static void
+_echart_heatmap_smart_clip_unset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_unset(sd->common.bg);
+    evas_object_clip_unset(sd->common.title);
+    evas_object_clip_unset(sd->common.img);
+}
+
+/*
+ * Quantize the columns not drawn yet, or all of them if the color range
+ * is changed by the new values.
+ */
+static Eina_Bool
+_echart_heatmap_quantize(Echart_Smart_Data *sd)
+{
+    unsigned int first;
+
+    if (sd->columns > sd->q_columns)
+    {
+        unsigned char *q;
+        unsigned int nbr;
+
+        nbr = (sd->columns > 2 * sd->q_columns) ? sd->columns : 2 * sd->q_columns;
+        q = (unsigned char *)realloc(sd->q, nbr * sd->rows);
+        if (!q)
+        {
+            ERR("Could not allocate the quantized values.");
+            return EINA_FALSE;
+        }
+        sd->q = q;
+        sd->q_columns = nbr;
+    }
+
+    if (!sd->range_set)
+    {
+        double min;
+        double max;
+
+        if (sd->full)
+            echart_colormap_range_get(sd->values, sd->columns * sd->rows,
+                                      &sd->data_min, &sd->data_max);
+        else
+        {
+            echart_colormap_range_get(sd->values + sd->q_done * sd->rows,
+                                      (sd->columns - sd->q_done) * sd->rows,
+                                      &min, &max);
+            if ((min < sd->data_min) || (max > sd->data_max))
+            {
+                if (min < sd->data_min) sd->data_min = min;
+                if (max > sd->data_max) sd->data_max = max;
+                sd->full = EINA_TRUE;
+            }
+        }
+    }
+
+    first = sd->full ? 0 : sd->q_done;
+    echart_colormap_quantize(sd->values + first * sd->rows,
+                             (sd->columns - first) * sd->rows,
+                             sd->range_set ? sd->min : sd->data_min,
+                             sd->range_set ? sd->max : sd->data_max,
+                             sd->q + first * sd->rows);
+
+    return EINA_TRUE;
+}
+
+static void
+_echart_heatmap_draw(Echart_Smart_Data *sd)
+{
+    Echart_Colormap cm;
+    unsigned int *data;
+    unsigned int capacity;
+    int x0;
+    int x1;
+    int w;
+    int h;
+
+    w = sd->common.w_vg;
+    h = sd->common.h_vg;
+    if ((w <= 0) || (h <= 0))
+        return;
+
+    capacity = (sd->columns_max > sd->columns) ? sd->columns_max : sd->columns;
+    if ((w != sd->w_img) || (h != sd->h_img) || (capacity != sd->capacity))
+        sd->full = EINA_TRUE;
+
+    if (!sd->full && (sd->q_done == sd->columns))
+        return;
+
+    if (!_echart_heatmap_quantize(sd))
+        return;
+
+    cm.q = sd->q;
+    cm.rows = sd->rows;
+    cm.columns = sd->columns;
+    cm.capacity = capacity;
+    cm.lut = sd->lut;
+    cm.filter = sd->filter;
+
+    if (sd->full)
+    {
+        x0 = 0;
+        x1 = w;
+        if ((w != sd->w_img) || (h != sd->h_img))
+            evas_object_image_size_set(sd->common.img, w, h);
+    }
+    else
+    {
+        /* the pixels on the right of the new columns stay transparent */
+        x0 = echart_colormap_pixel_get(&cm, w, sd->q_done);
+        x1 = echart_colormap_pixel_get(&cm, w, sd->columns + 2) + 2;
+        if (x1 > w)
+            x1 = w;
+    }
+
+    data = (unsigned int *)evas_object_image_data_get(sd->common.img, EINA_TRUE);
+    if (!data)
+    {
+        ERR("Could not get the image data for writing.");
+        return;
+    }
+
+    echart_colormap_draw(&cm, data,
+                         evas_object_image_stride_get(sd->common.img) / 4,
+                         w, h, x0, x1);
+
+    evas_object_image_data_set(sd->common.img, data);
+    if (x1 > x0)
+        evas_object_image_data_update_add(sd->common.img, x0, 0, x1 - x0, h);
+
+    sd->q_done = sd->columns;
+    sd->capacity = capacity;
+    sd->w_img = w;
+    sd->h_img = h;
+    sd->full = EINA_FALSE;
+}
+
+static void
+_echart_heatmap_smart_calculate(Evas_Object *obj)
+{
+    Echart_Font_Style fs;
+    Echart_Smart_Data *sd;
+    unsigned int col;
+    int w;
+    int h;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    sd->common.padding = 0;
+
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
+    col = echart_chart_background_color_get(sd->common.chart);
+
+    /* background */
+    echart_background_set((Echart_Smart_Common *)sd, w, h, col);
+
+    /* title */
+    if (echart_chart_title_get(sd->common.chart))
+    {
+        Evas_Coord w_title;
+
+        echart_chart_title_style_get(sd->common.chart, &fs);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
+        evas_object_move(sd->common.title, (w - w_title) / 2, 0);
+    }
+
+    /* image only */
+    echart_vg_set((Echart_Smart_Common *)sd);
+    evas_object_hide(sd->common.vg);
+
+    if (!sd->values)
+    {
+        evas_object_hide(sd->common.img);
+        return;
+    }
+
+    if (evas_object_visible_get(obj))
+        evas_object_show(sd->common.img);
+
+    _echart_heatmap_draw(sd);
+}
+
+static void
+_echart_heatmap_smart_init(void)
+{
+    static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION(ECHART_HEATMAP_OBJ_NAME);
+
+    if (_echart_heatmap_smart) return;
+
+    if (!sc.add)
+    {
+        sc.add = _echart_heatmap_smart_add;
+        sc.del = _echart_heatmap_smart_del;
+        sc.move = _echart_heatmap_smart_move;
+        sc.resize = _echart_heatmap_smart_resize;
+        sc.show = _echart_heatmap_smart_show;
+        sc.hide = _echart_heatmap_smart_hide;
+        sc.clip_set = _echart_heatmap_smart_clip_set;
+        sc.clip_unset = _echart_heatmap_smart_clip_unset;
+        sc.calculate = _echart_heatmap_smart_calculate;
+    }
+    _echart_heatmap_smart = evas_smart_class_new(&sc);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Evas_Object *
+echart_heatmap_object_add(Evas *evas)
+{
+    Evas_Object *obj;
+
+    _echart_heatmap_smart_init();
+    obj = evas_object_smart_add(evas, _echart_heatmap_smart);
+
+    return obj;
+}
+
+EAPI void
+echart_heatmap_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+    INF("chart set");
+
+    sd->common.chart = chart;
+    sd->full = EINA_TRUE;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_heatmap_object_matrix_set(Evas_Object *obj,
+                                 const double *values,
+                                 unsigned int rows,
+                                 unsigned int columns,
+                                 Eina_Bool copy)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    free(sd->own);
+    sd->own = NULL;
+    sd->own_columns = 0;
+    sd->values = NULL;
+    sd->rows = 0;
+    sd->columns = 0;
+    sd->q_done = 0;
+    sd->full = EINA_TRUE;
+
+    /* the quantized values depend on the number of rows */
+    free(sd->q);
+    sd->q = NULL;
+    sd->q_columns = 0;
+
+    if (values && rows && columns)
+    {
+        if (copy)
+        {
+            sd->own = (double *)malloc(rows * columns * sizeof(double));
+            if (!sd->own)
+            {
+                ERR("Could not allocate the matrix.");
+                goto recalc;
+            }
+            memcpy(sd->own, values, rows * columns * sizeof(double));
+            sd->own_columns = columns;
+            values = sd->own;
+        }
+        sd->values = values;
+        sd->rows = rows;
+        sd->columns = columns;
+    }
+
+  recalc:
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+/*
+ * Append columns to the matrix. With values, they are copied, the matrix
+ * of the caller being copied first if needed. Without values, the buffer
+ * of the caller is expected to have been filled with columns more.
+ */
+EAPI void
+echart_heatmap_object_columns_append(Evas_Object *obj,
+                                     const double *values,
+                                     unsigned int columns)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    if (!sd->values || !columns)
+        return;
+
+    if (!values)
+    {
+        if (sd->own)
+        {
+            ERR("The matrix is a copy, the columns must be given.");
+            return;
+        }
+    }
+    else
+    {
+        if (sd->columns + columns > sd->own_columns)
+        {
+            double *own;
+            unsigned int nbr;
+
+            nbr = 2 * (sd->columns + columns);
+            own = (double *)realloc(sd->own, nbr * sd->rows * sizeof(double));
+            if (!own)
+            {
+                ERR("Could not allocate the matrix.");
+                return;
+            }
+            if (!sd->own)
+                memcpy(own, sd->values, sd->columns * sd->rows * sizeof(double));
+            sd->own = own;
+            sd->own_columns = nbr;
+            sd->values = own;
+        }
+        memcpy(sd->own + sd->columns * sd->rows, values,
+               columns * sd->rows * sizeof(double));
+    }
+
+    sd->columns += columns;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+/*
+ * Number of columns spanning the width of the image, 0 (default) for the
+ * number of columns of the matrix. With a fixed number, the columns
+ * appended are drawn without redrawing the other ones.
+ */
+EAPI void
+echart_heatmap_object_columns_max_set(Evas_Object *obj, unsigned int columns)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    sd->columns_max = columns;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_heatmap_object_range_set(Evas_Object *obj, double min, double max)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    if (min >= max)
+    {
+        ERR("invalid range [%g, %g]", min, max);
+        return;
+    }
+
+    sd->min = min;
+    sd->max = max;
+    sd->range_set = EINA_TRUE;
+    sd->full = EINA_TRUE;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_heatmap_object_range_reset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    sd->range_set = EINA_FALSE;
+    sd->full = EINA_TRUE;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+/* colors of the ramp, ARGB, from the minimum to the maximum */
+EAPI void
+echart_heatmap_object_ramp_set(Evas_Object *obj,
+                               const unsigned int *colors,
+                               unsigned int nbr)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    echart_colormap_lut_set(sd->lut, colors, nbr);
+    sd->full = EINA_TRUE;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_heatmap_object_filter_set(Evas_Object *obj, Echart_Heatmap_Filter filter)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_HEATMAP_SMART_OBJ_GET(sd, obj, ECHART_HEATMAP_OBJ_NAME);
+
+    if (sd->filter == filter)
+        return;
+
+    sd->filter = filter;
+    sd->full = EINA_TRUE;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
@@ -0,0 +1,55 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_HEATMAP_H
+#define ECHART_HEATMAP_H
+
+/* resampling of the matrix to the size of the image */
+typedef enum
+{
+    ECHART_HEATMAP_FILTER_NEAREST, /* one cell per pixel (default) */
+    ECHART_HEATMAP_FILTER_BILINEAR /* interpolation of the 4 nearest cells */
+} Echart_Heatmap_Filter;
+
+EAPI Evas_Object *echart_heatmap_object_add(Evas *evas);
+EAPI void echart_heatmap_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
+
+/*
+ * The matrix is stored column by column: the rows values of the column
+ * c start at values + c * rows, the row 0 being at the bottom. If copy
+ * is EINA_FALSE, the buffer is used as is and must stay valid until the
+ * matrix is replaced or the object deleted.
+ */
+EAPI void echart_heatmap_object_matrix_set(Evas_Object *obj,
+                                           const double *values,
+                                           unsigned int rows,
+                                           unsigned int columns,
+                                           Eina_Bool copy);
+EAPI void echart_heatmap_object_columns_append(Evas_Object *obj,
+                                               const double *values,
+                                               unsigned int columns);
+EAPI void echart_heatmap_object_columns_max_set(Evas_Object *obj, unsigned int columns);
+
+EAPI void echart_heatmap_object_range_set(Evas_Object *obj, double min, double max);
+EAPI void echart_heatmap_object_range_reset(Evas_Object *obj);
+EAPI void echart_heatmap_object_ramp_set(Evas_Object *obj,
+                                         const unsigned int *colors,
+                                         unsigned int nbr);
+EAPI void echart_heatmap_object_filter_set(Evas_Object *obj, Echart_Heatmap_Filter filter);
+
+#endif /* ECHART_HEATMAP_H */
@@ -0,0 +1,477 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <Eina.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_thread.h"
+#include "echart_histogram.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * The samples are split in chunks counted in parallel, each chunk in
+ * its own partial histogram, so that the threads never write to the
+ * same counters. The partial histograms are summed at the end, which
+ * costs the number of bins per chunk, not per sample.
+ */
+
+#define ECHART_HISTOGRAM_CHUNK_MIN 65536
+#define ECHART_HISTOGRAM_BINS_MAX 65536
+/* bins of the first pass estimating the quartiles, for the auto mode */
+#define ECHART_HISTOGRAM_QUARTILE_BINS 4096
+
+struct _Echart_Histogram
+{
+    const Echart_Serie *samples;
+    Echart_Histogram_Bins bins;
+    double value;
+    double min; /* range set with echart_histogram_range_set() */
+    double max;
+    unsigned int *counts;
+    unsigned int nbr;
+    double bin_min;
+    double bin_width;
+    unsigned int binned; /* samples counted in counts */
+    Eina_Bool range : 1;
+    Eina_Bool dirty : 1;
+};
+
+typedef struct
+{
+    const double *values;
+    size_t count;
+    size_t chunk;
+    double min;
+    double max;
+    double scale; /* bins per unit */
+    unsigned int nbr;
+    unsigned int *partials; /* nbr counts per chunk */
+} Echart_Histogram_Job;
+
+static void
+_echart_histogram_chunk_job(void *data, unsigned int idx)
+{
+    const Echart_Histogram_Job *job;
+    unsigned int *counts;
+    size_t first;
+    size_t last;
+    size_t k;
+
+    job = data;
+    first = idx * job->chunk;
+    last = first + job->chunk;
+    if (last > job->count)
+        last = job->count;
+
+    counts = job->partials + idx * job->nbr;
+    memset(counts, 0, job->nbr * sizeof(unsigned int));
+    for (k = first; k < last; k++)
+    {
+        double v;
+        unsigned int b;
+
+        v = job->values[k];
+        /* NaN and values out of the range are not counted */
+        if (!((v >= job->min) && (v <= job->max)))
+            continue;
+        b = (unsigned int)((v - job->min) * job->scale);
+        /* the maximum is in the last bin */
+        if (b >= job->nbr)
+            b = job->nbr - 1;
+        counts[b]++;
+    }
+}
+
+/* count the values in nbr bins spanning [min, max] */
+static Eina_Bool
+_echart_histogram_count(const double *values, size_t count,
+                        double min, double max,
+                        unsigned int nbr, unsigned int *counts)
+{
+    Echart_Histogram_Job job;
+    unsigned int nbr_chunks;
+    unsigned int i;
+    unsigned int b;
+
+    nbr_chunks = echart_thread_count();
+    if (nbr_chunks > count / ECHART_HISTOGRAM_CHUNK_MIN)
+        nbr_chunks = count / ECHART_HISTOGRAM_CHUNK_MIN;
+    if (nbr_chunks < 1)
+        nbr_chunks = 1;
+
+    job.values = values;
+    job.count = count;
+    job.chunk = (count + nbr_chunks - 1) / nbr_chunks;
+    job.min = min;
+    job.max = max;
+    job.scale = (max > min) ? nbr / (max - min) : 0;
+    job.nbr = nbr;
+
+    if (nbr_chunks == 1)
+    {
+        job.partials = counts;
+        _echart_histogram_chunk_job(&job, 0);
+        return EINA_TRUE;
+    }
+
+    job.partials = (unsigned int *)malloc(nbr_chunks * nbr * sizeof(unsigned int));
+    if (!job.partials)
+    {
+        ERR("Could not allocate the partial histograms.");
+        return EINA_FALSE;
+    }
+
+    echart_thread_run(nbr_chunks, _echart_histogram_chunk_job, &job);
+
+    memcpy(counts, job.partials, nbr * sizeof(unsigned int));
+    for (i = 1; i < nbr_chunks; i++)
+    {
+        const unsigned int *partial;
+
+        partial = job.partials + i * nbr;
+        for (b = 0; b < nbr; b++)
+            counts[b] += partial[b];
+    }
+
+    free(job.partials);
+
+    return EINA_TRUE;
+}
+
+/* value below which there are q samples, from a histogram */
+static double
+_echart_histogram_quantile_get(const unsigned int *counts, unsigned int nbr,
+                               double min, double width, double q)
+{
+    double sum;
+    unsigned int b;
+
+    sum = 0;
+    for (b = 0; b < nbr; b++)
+    {
+        if (counts[b] && (sum + counts[b] >= q))
+            return min + (b + (q - sum) / counts[b]) * width;
+        sum += counts[b];
+    }
+
+    return min + nbr * width;
+}
+
+/*
+ * Freedman-Diaconis rule: the width of the bins is 2 IQR / n^(1/3). The
+ * quartiles are interpolated in a first, finer, histogram so that the
+ * samples are not sorted. If they are equal, the Sturges rule is used.
+ */
+static unsigned int
+_echart_histogram_auto_nbr_get(const double *values, size_t count,
+                               double min, double max)
+{
+    unsigned int *counts;
+    double width;
+    double total;
+    double q1;
+    double q3;
+    double nbr;
+    unsigned int b;
+
+    counts = (unsigned int *)malloc(ECHART_HISTOGRAM_QUARTILE_BINS * sizeof(unsigned int));
+    if (!counts)
+        return 1;
+
+    if (!_echart_histogram_count(values, count, min, max,
+                                 ECHART_HISTOGRAM_QUARTILE_BINS, counts))
+    {
+        free(counts);
+        return 1;
+    }
+
+    total = 0;
+    for (b = 0; b < ECHART_HISTOGRAM_QUARTILE_BINS; b++)
+        total += counts[b];
+
+    width = (max - min) / ECHART_HISTOGRAM_QUARTILE_BINS;
+    q1 = _echart_histogram_quantile_get(counts, ECHART_HISTOGRAM_QUARTILE_BINS,
+                                        min, width, total / 4);
+    q3 = _echart_histogram_quantile_get(counts, ECHART_HISTOGRAM_QUARTILE_BINS,
+                                        min, width, 3 * total / 4);
+    free(counts);
+
+    if ((total < 1) || (q3 <= q1))
+        nbr = ceil(log(total + 1) / log(2)) + 1;
+    else
+        nbr = ceil((max - min) / (2 * (q3 - q1) / cbrt(total)));
+
+    if (nbr < 1)
+        nbr = 1;
+    if (nbr > ECHART_HISTOGRAM_BINS_MAX)
+        nbr = ECHART_HISTOGRAM_BINS_MAX;
+
+    return (unsigned int)nbr;
+}
+
+/* bin the samples again if they, the bins or the range changed */
+static Eina_Bool
+_echart_histogram_update(Echart_Histogram *h)
+{
+    const Eina_Inarray *values;
+    unsigned int *counts;
+    double min;
+    double max;
+    double nbr;
+    Eina_Bool capped;
+
+    values = echart_serie_values_get(h->samples);
+    if (!h->dirty && (h->binned == values->len))
+        return EINA_TRUE;
+
+    if (h->range)
+    {
+        min = h->min;
+        max = h->max;
+    }
+    else
+        echart_serie_interval_get(h->samples, &min, &max);
+
+    if (!values->len)
+        nbr = 0;
+    else if (h->bins == ECHART_HISTOGRAM_BINS_COUNT)
+        nbr = h->value;
+    else if (h->bins == ECHART_HISTOGRAM_BINS_WIDTH)
+        nbr = ceil((max - min) / h->value);
+    else if (max > min)
+        nbr = _echart_histogram_auto_nbr_get((const double *)values->members,
+                                             values->len, min, max);
+    else
+        nbr = 1;
+
+    if ((nbr < 1) && values->len)
+        nbr = 1;
+    capped = EINA_FALSE;
+    if (nbr > ECHART_HISTOGRAM_BINS_MAX)
+    {
+        nbr = ECHART_HISTOGRAM_BINS_MAX;
+        capped = EINA_TRUE;
+        /* the range is kept, the bins are widened */
+        if (h->bins == ECHART_HISTOGRAM_BINS_WIDTH)
+            WRN("Bins of width %g too small, %d bins of width %g used.",
+                h->value, ECHART_HISTOGRAM_BINS_MAX, (max - min) / nbr);
+    }
+
+    if (max <= min)
+    {
+        /* a single value, in the middle of a bin of width 1 */
+        min -= 0.5;
+        max = min + nbr;
+    }
+    else if ((h->bins == ECHART_HISTOGRAM_BINS_WIDTH) && !capped)
+        max = min + nbr * h->value;
+
+    counts = NULL;
+    if (nbr >= 1)
+    {
+        counts = (unsigned int *)realloc(h->counts, (size_t)nbr * sizeof(unsigned int));
+        if (!counts)
+        {
+            ERR("Could not allocate the histogram.");
+            return EINA_FALSE;
+        }
+        h->counts = counts;
+
+        if (!_echart_histogram_count((const double *)values->members,
+                                     values->len, min, max,
+                                     (unsigned int)nbr, counts))
+            return EINA_FALSE;
+    }
+
+    h->nbr = (unsigned int)nbr;
+    h->bin_min = min;
+    h->bin_width = (nbr >= 1) ? (max - min) / nbr : 0;
+    h->binned = values->len;
+    h->dirty = EINA_FALSE;
+
+    return EINA_TRUE;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Echart_Histogram *
+echart_histogram_new(const Echart_Serie *samples)
+{
+    Echart_Histogram *h;
+
+    if (!samples)
+        return NULL;
+
+    h = (Echart_Histogram *)calloc(1, sizeof(Echart_Histogram));
+    if (!h)
+        return NULL;
+
+    h->samples = samples;
+    h->bins = ECHART_HISTOGRAM_BINS_AUTO;
+    h->dirty = EINA_TRUE;
+
+    return h;
+}
+
+EAPI void
+echart_histogram_free(Echart_Histogram *h)
+{
+    if (!h)
+        return;
+
+    free(h->counts);
+    free(h);
+}
+
+EAPI void
+echart_histogram_bins_set(Echart_Histogram *h, Echart_Histogram_Bins bins, double value)
+{
+    if (!h)
+        return;
+
+    if ((bins != ECHART_HISTOGRAM_BINS_AUTO) && !(value > 0))
+    {
+        WRN("The number or the width of the bins must be positive");
+        return;
+    }
+
+    h->bins = bins;
+    h->value = (bins == ECHART_HISTOGRAM_BINS_COUNT) ? floor(value) : value;
+    h->dirty = EINA_TRUE;
+}
+
+EAPI void
+echart_histogram_range_set(Echart_Histogram *h, double min, double max)
+{
+    if (!h || !(max > min))
+        return;
+
+    if (h->range && (h->min == min) && (h->max == max))
+        return;
+
+    h->min = min;
+    h->max = max;
+    h->range = EINA_TRUE;
+    h->dirty = EINA_TRUE;
+}
+
+EAPI void
+echart_histogram_range_reset(Echart_Histogram *h)
+{
+    if (!h || !h->range)
+        return;
+
+    h->range = EINA_FALSE;
+    h->dirty = EINA_TRUE;
+}
+
+EAPI const unsigned int *
+echart_histogram_counts_get(Echart_Histogram *h,
+                            unsigned int *nbr,
+                            double *min,
+                            double *width)
+{
+    if (nbr) *nbr = 0;
+    if (min) *min = 0;
+    if (width) *width = 0;
+
+    if (!h || !_echart_histogram_update(h))
+        return NULL;
+
+    if (nbr) *nbr = h->nbr;
+    if (min) *min = h->bin_min;
+    if (width) *width = h->bin_width;
+
+    return h->counts;
+}
+
+EAPI Echart_Data *
+echart_histogram_data_new(Echart_Histogram *h)
+{
+    const unsigned int *counts;
+    Echart_Data *d;
+    Echart_Serie *s;
+    double min;
+    double width;
+    unsigned int nbr;
+    unsigned int i;
+
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    if (!counts)
+        return NULL;
+
+    d = echart_data_new();
+    if (!d)
+        return NULL;
+
+    if (echart_serie_title_get(h->samples))
+        echart_data_title_set(d, echart_serie_title_get(h->samples));
+
+    s = echart_serie_new();
+    if (!s)
+        goto free_d;
+    for (i = 0; i < nbr; i++)
+        echart_serie_value_push(s, min + (i + 0.5) * width);
+    echart_data_absciss_set(d, s);
+
+    s = echart_serie_new();
+    if (!s)
+        goto free_d;
+    echart_serie_title_set(s, "Count");
+    for (i = 0; i < nbr; i++)
+        echart_serie_value_push(s, counts[i]);
+    if (!echart_data_serie_append(d, s))
+    {
+        echart_serie_free(s);
+        goto free_d;
+    }
+
+    echart_data_ymin_set(d, 0);
+
+    return d;
+
+  free_d:
+    echart_data_free(d);
+
+    return NULL;
+}
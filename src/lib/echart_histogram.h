@@ -0,0 +1,54 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_HISTOGRAM_H
+#define ECHART_HISTOGRAM_H
+
+/* choice of the bins */
+typedef enum
+{
+    ECHART_HISTOGRAM_BINS_AUTO,  /* width from the Freedman-Diaconis rule (default) */
+    ECHART_HISTOGRAM_BINS_COUNT, /* fixed number of bins */
+    ECHART_HISTOGRAM_BINS_WIDTH  /* fixed width of the bins */
+} Echart_Histogram_Bins;
+
+typedef struct _Echart_Histogram Echart_Histogram;
+
+/*
+ * Distribution of the values of samples, which must stay valid until
+ * the histogram is freed. The samples are binned again when they are
+ * appended or when the bins or the range change.
+ */
+EAPI Echart_Histogram *echart_histogram_new(const Echart_Serie *samples);
+EAPI void echart_histogram_free(Echart_Histogram *h);
+EAPI void echart_histogram_bins_set(Echart_Histogram *h, Echart_Histogram_Bins bins, double value);
+EAPI void echart_histogram_range_set(Echart_Histogram *h, double min, double max);
+EAPI void echart_histogram_range_reset(Echart_Histogram *h);
+EAPI const unsigned int *echart_histogram_counts_get(Echart_Histogram *h,
+                                                     unsigned int *nbr,
+                                                     double *min,
+                                                     double *width);
+
+/*
+ * New data for the vbar object: the absciss is the center of the bins
+ * and the only serie their counts. It must be freed with
+ * echart_data_free().
+ */
+EAPI Echart_Data *echart_histogram_data_new(Echart_Histogram *h);
+
+#endif /* ECHART_HISTOGRAM_H */
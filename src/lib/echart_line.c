@@ -32,7 +32,11 @@
 #include "echart_data.h"
 #include "echart_chart.h"
 #include "echart_common.h"
+#include "echart_text.h"
+#include "echart_raster.h"
 #include "echart_line.h"
+#include "echart_lod.h"
+#include "echart_trace.h"
 
 /*============================================================================*
  *                                  Local                                     *
@@ -66,12 +70,71 @@
 
 #define ECHART_LINE_OBJ_NAME "echart_line_object"
 
+/* half size of the box around the cursor where the points are hovered */
+#define ECHART_LINE_HIT_RADIUS 3
+
+/* layout of the last frame, for the hit-testing */
+typedef struct
+{
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    Evas_Coord left; /* position of the plot in the canvas */
+    Evas_Coord top;
+    unsigned int first; /* samples drawn */
+    unsigned int last;
+    Eina_Bool sorted : 1;
+    Eina_Bool stacked : 1; /* the stacked values are in common.stack */
+    Eina_Bool valid : 1;
+} Echart_Line_Layout;
+
+/* samples of a serie decimated in a previous frame */
+typedef struct
+{
+    const double *xv; /* samples decimated */
+    const double *yv;
+    unsigned int first;
+    unsigned int last;
+    double xmin;
+    double xmax;
+    unsigned int columns; /* pixel columns of the decimation */
+    unsigned int nbr; /* decimated samples, 0 if none */
+} Echart_Line_Decimation;
+
 typedef struct
 {
     Echart_Smart_Common common;
-    Efl_VG *dot;
+    Efl_VG *dot; /* in the overlay */
+    Evas_Coord dot_x;
+    Evas_Coord dot_y;
+    unsigned int dot_color;
+    Eina_Bool dot_visible;
+    Echart_Lod *lods; /* level of detail of each serie, last frame */
+    unsigned int nbr_lods;
+    double *lod_x;
+    double *lod_y;
+    unsigned int lod_size;
+    unsigned int lod_columns; /* columns of a part of the buffers */
+    Echart_Line_Decimation *decimations;
+    Eina_Bool lod_reuse; /* only resized, see _echart_line_lod_apply() */
+    Efl_VG *series_node; /* container of the series, in the VG backend */
+    Echart_Viewport built; /* window of the shapes of the series */
+    Eina_Bool interactive; /* the window changes move the shapes */
+    Eina_Bool need_transform;
+    Eina_Bool transformed; /* the shapes are not exact */
+    Echart_Line_Layout layout;
 } Echart_Smart_Data;
 
+/* samples [first, last] of a serie, as they are drawn */
+typedef struct
+{
+    const double *xv;
+    const double *yv;
+    unsigned int first;
+    unsigned int last;
+} Echart_Line_Points;
+
 static Evas_Smart *_echart_line_smart = NULL;
 
 static void
@@ -85,131 +148,236 @@ _echart_line_coords_get(const Echart_Smart_Data *sd,
     *yvg = sd->common.padding + (sd->common.h_vg - 2 * sd->common.padding) * (ymax - y) / (ymax - ymin);
 }
 
+/* the dot is only updated when it changes, the data are never redrawn */
 static void
-_echart_line_mouse_move_cb(void *d, Evas *evas EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event)
+_echart_line_dot_set(Echart_Smart_Data *sd, Eina_Bool visible,
+                     Evas_Coord x, Evas_Coord y, unsigned int col)
+{
+    if (!visible)
+    {
+        if (sd->dot_visible)
+        {
+            evas_vg_node_visible_set(sd->dot, EINA_FALSE);
+            sd->dot_visible = EINA_FALSE;
+        }
+        return;
+    }
+
+    if (sd->dot_visible &&
+        (sd->dot_x == x) && (sd->dot_y == y) && (sd->dot_color == col))
+        return;
+
+    evas_vg_shape_reset(sd->dot);
+    evas_vg_shape_append_circle(sd->dot, x, y, 5);
+    evas_vg_node_color_set(sd->dot,
+                           COL_TO_R(col), COL_TO_G(col),
+                           COL_TO_B(col), COL_TO_A(col));
+    evas_vg_node_visible_set(sd->dot, EINA_TRUE);
+    sd->dot_x = x;
+    sd->dot_y = y;
+    sd->dot_color = col;
+    sd->dot_visible = EINA_TRUE;
+}
+
+static void
+_echart_line_layout_set(Echart_Smart_Data *sd, const Echart_Data *data,
+                        double xmin, double xmax,
+                        double ymin, double ymax)
 {
-    Echart_Smart_Data *sd;
-    Evas_Event_Mouse_Move *ev;
-    const Echart_Data *data;
     const Echart_Serie *absciss;
-    const Echart_Serie *serie;
-    const Eina_List *series;
-    const Eina_List *l;
     const Eina_Inarray *x_values;
-    Echart_Colors cols;
-    Echart_Offsets offsets;
-    Evas_Coord xd;
-    Evas_Coord yd;
-    double *xv;
-    double ymin;
-    double ymax;
-    int n;
-    Eina_Bool has_dot;
-
-    sd = d;
-    ev = event;
+    Evas_Coord x;
+    Evas_Coord y;
 
-    echart_offsets_get(sd->common.title, &offsets);
+    sd->layout.valid = EINA_FALSE;
 
-    data = echart_chart_data_get(sd->common.chart);
     absciss = echart_data_absciss_get(data);
-    series = echart_data_series_get(data);
-
     x_values = echart_serie_values_get(absciss);
-    xv = (double *)x_values->members;
+    if (!x_values || !x_values->len)
+        return;
 
-    echart_data_interval_get(data, &ymin, &ymax);
-    n = (int)floor(log(ymax - ymin) / log(10));
-    ymax = (floor(ymax / pow(10, n - 1)) + 1) * pow(10, n - 1);
+    /* the plot has been placed by echart_vg_set() */
+    evas_object_geometry_get(sd->common.vg, &x, &y, NULL, NULL);
+
+    sd->layout.xmin = xmin;
+    sd->layout.xmax = xmax;
+    sd->layout.ymin = ymin;
+    sd->layout.ymax = ymax;
+    sd->layout.left = x;
+    sd->layout.top = y;
+    sd->layout.sorted = echart_serie_sorted_get(absciss);
+    sd->layout.stacked = echart_data_stacked_get(data);
+    echart_viewport_range_get((const double *)x_values->members,
+                              x_values->len, sd->layout.sorted,
+                              xmin, xmax,
+                              &sd->layout.first, &sd->layout.last);
+    sd->layout.valid = EINA_TRUE;
+}
 
-    has_dot = EINA_FALSE;
+/*
+ * Sample nearest to the canvas position (cx, cy), among the samples
+ * drawn within ECHART_LINE_HIT_RADIUS pixels. The samples whose absciss
+ * is in the box are found with a binary search, on the absciss if it is
+ * sorted, on its order otherwise, so only these samples are tested.
+ */
+static Eina_Bool
+_echart_line_nearest_get(Echart_Smart_Data *sd,
+                         Evas_Coord cx, Evas_Coord cy,
+                         const Echart_Serie **serie,
+                         unsigned int *index,
+                         Evas_Coord *xd, Evas_Coord *yd)
+{
+    const Echart_Data *data;
+    const Echart_Serie *s;
+    const Eina_List *series;
+    const Eina_List *l;
+    const Eina_Inarray *x_values;
+    const unsigned int *order;
+    const double *xv;
+    double ax;
+    double x0;
+    double x1;
+    unsigned int lo;
+    unsigned int hi;
+    unsigned int n;
+    unsigned int k;
+    int dmin;
+
+    if (!sd->layout.valid)
+        return EINA_FALSE;
 
-    EINA_LIST_FOREACH(series, l, serie)
+    data = echart_chart_data_get(sd->common.chart);
+    x_values = echart_serie_values_get(echart_data_absciss_get(data));
+    if (!x_values || (x_values->len <= sd->layout.last))
+        return EINA_FALSE;
+    xv = (const double *)x_values->members;
+
+    /* absciss of the box around the cursor */
+    ax = (sd->common.w_vg - 2 * sd->common.padding) /
+         (sd->layout.xmax - sd->layout.xmin);
+    if (ax <= 0)
+        return EINA_FALSE;
+    x0 = sd->layout.xmin +
+         (cx - sd->layout.left - sd->common.padding - ECHART_LINE_HIT_RADIUS) / ax;
+    x1 = sd->layout.xmin +
+         (cx - sd->layout.left - sd->common.padding + ECHART_LINE_HIT_RADIUS) / ax;
+
+    order = NULL;
+    if (sd->layout.sorted)
     {
-        const Eina_Inarray *y_values;
-        double *yv;
-        Evas_Coord x;
-        Evas_Coord y;
-        size_t i;
+        echart_viewport_range_get(xv + sd->layout.first,
+                                  sd->layout.last - sd->layout.first + 1,
+                                  EINA_TRUE, x0, x1, &lo, &hi);
+    }
+    else
+    {
+        /* shared by all the charts of the data */
+        order = echart_serie_order_get(echart_data_absciss_get(data));
+        if (!order)
+            return EINA_FALSE;
+
+        /* first sample with x >= x0, then first sample with x > x1 */
+        lo = 0;
+        hi = x_values->len;
+        while (lo < hi)
+        {
+            k = lo + (hi - lo) / 2;
+            if (xv[order[k]] < x0)
+                lo = k + 1;
+            else
+                hi = k;
+        }
+        hi = x_values->len;
+        n = lo;
+        while (n < hi)
+        {
+            k = n + (hi - n) / 2;
+            if (xv[order[k]] <= x1)
+                n = k + 1;
+            else
+                hi = k;
+        }
+        if (lo >= n)
+            return EINA_FALSE;
+        hi = n - 1;
+    }
 
-        y_values = echart_serie_values_get(serie);
-        yv = (double *)y_values->members;
+    n = sd->layout.last - sd->layout.first + 1;
+    dmin = -1;
+    series = echart_data_series_get(data);
+    for (k = lo; k <= hi; k++)
+    {
+        unsigned int i;
+        unsigned int idx;
+
+        i = order ? order[k] : sd->layout.first + k;
+        if ((i < sd->layout.first) || (i > sd->layout.last))
+            continue;
 
-        for (i = 0; i < x_values->len; i++)
+        idx = 0;
+        EINA_LIST_FOREACH(series, l, s)
         {
+            const Eina_Inarray *y_values;
+            double y;
+            Evas_Coord x_vg;
+            Evas_Coord y_vg;
+            int dx;
+            int dy;
+
+            y_values = echart_serie_values_get(s);
+            idx++;
+            if (y_values->len < x_values->len)
+                continue;
+
+            if (sd->layout.stacked && sd->common.stack)
+                y = sd->common.stack[(idx - 1) * n + i - sd->layout.first];
+            else
+                y = ((const double *)y_values->members)[i];
+
             _echart_line_coords_get(sd,
-                                    xv[0], xv[x_values->len - 1],
-                                    ymin, ymax,
-                                    xv[i], yv[i],
-                                    &x, &y);
-            if ((ev->cur.canvas.x >= (x + offsets.left - 3)) &&
-                (ev->cur.canvas.x <= (x + offsets.left + 3)) &&
-                (ev->cur.canvas.y >= (y + offsets.top - 3)) &&
-                (ev->cur.canvas.y <= (y + offsets.top + 3)))
+                                    sd->layout.xmin, sd->layout.xmax,
+                                    sd->layout.ymin, sd->layout.ymax,
+                                    xv[i], y,
+                                    &x_vg, &y_vg);
+            dx = cx - (sd->layout.left + x_vg);
+            dy = cy - (sd->layout.top + y_vg);
+            if ((dx < -ECHART_LINE_HIT_RADIUS) || (dx > ECHART_LINE_HIT_RADIUS) ||
+                (dy < -ECHART_LINE_HIT_RADIUS) || (dy > ECHART_LINE_HIT_RADIUS))
+                continue;
+
+            if ((dmin < 0) || (dx * dx + dy * dy < dmin))
             {
-                has_dot = EINA_TRUE;
-                xd = x;
-                yd = y;
-                cols = echart_serie_color_get(serie);
+                dmin = dx * dx + dy * dy;
+                *serie = s;
+                *index = i;
+                *xd = x_vg;
+                *yd = y_vg;
             }
-
         }
     }
 
-    if (has_dot)
-    {
-        if (!sd->dot)
-        {
-            sd->dot = evas_vg_shape_add(sd->common.root);
-            evas_vg_shape_append_circle(sd->dot, xd, yd, 5);
-            evas_vg_node_color_set(sd->dot,
-                                   COL_TO_R(cols.line),
-                                   COL_TO_G(cols.line),
-                                   COL_TO_B(cols.line),
-                                   COL_TO_A(cols.line));
-        }
-    }
-    else
-    {
-        evas_vg_shape_reset(sd->dot);
-        sd->dot = NULL;
-    }
+    return dmin >= 0;
 }
 
+/* hovered sample, at most once per frame */
 static void
-_echart_text_object_set(Evas_Object *obj,
-                        const char *text,
-                        const Echart_Font_Style *fs)
+_echart_line_pointer_update(Echart_Smart_Data *sd)
 {
-    char buf[256];
-    char buf2[32];
-
-    if (!text)
-        return;
+    const Echart_Serie *serie;
+    Echart_Colors cols;
+    Evas_Coord xd;
+    Evas_Coord yd;
+    unsigned int i;
 
-    *buf2 = '\0';
-    if (fs->bold || fs->italic)
+    if (sd->common.pointer_in &&
+        _echart_line_nearest_get(sd, sd->common.pointer_x, sd->common.pointer_y,
+                                 &serie, &i, &xd, &yd))
     {
-        memcpy(buf2, ":style=", 7);
-        if (!fs->italic)
-            memcpy(buf2 + 7, "Bold", 5);
-        else if (!fs->bold)
-            memcpy(buf2 + 7, "Italic", 7);
-        else
-            memcpy(buf2 + 7, "Bold Italic", 12);
+        cols = echart_serie_color_get(serie);
+        _echart_line_dot_set(sd, EINA_TRUE, xd, yd, cols.line);
     }
-    snprintf(buf, sizeof(buf), "%s%s",
-             fs->font_name ? fs->font_name : "Sans", buf2);
-    buf[255] = '\0';
-
-    evas_object_text_style_set(obj, EVAS_TEXT_STYLE_PLAIN);
-    evas_object_color_set(obj,
-                          COL_TO_R(fs->font_color),
-                          COL_TO_G(fs->font_color),
-                          COL_TO_B(fs->font_color),
-                          COL_TO_A(fs->font_color));
-    evas_object_text_font_set(obj, buf, (fs->font_size <= 0) ? 13 : fs->font_size);
-    evas_object_text_text_set(obj, text);
+    else
+        _echart_line_dot_set(sd, EINA_FALSE, 0, 0, 0);
 }
 
 static void
@@ -217,7 +385,7 @@ _echart_line_smart_add(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = calloc(1, sizeof(Echart_Smart_Data));
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -231,9 +399,13 @@ _echart_line_smart_add(Evas_Object *obj)
     sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
     sd->common.root = evas_vg_container_add(sd->common.vg);
     evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+    echart_overlay_add((Echart_Smart_Common *)sd, evas_object_evas_get(obj));
+    sd->dot = evas_vg_shape_add(sd->common.overlay_root);
+    evas_vg_node_visible_set(sd->dot, EINA_FALSE);
 
-    evas_object_event_callback_add(sd->common.vg, EVAS_CALLBACK_MOUSE_MOVE,
-                                   _echart_line_mouse_move_cb, sd);
+    echart_pointer_callbacks_add((Echart_Smart_Common *)sd, obj);
+    sd->common.need_layout = EINA_TRUE;
 
     evas_object_smart_data_set(obj, sd);
 }
@@ -243,16 +415,28 @@ _echart_line_smart_del(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
     {
+        Evas_Object **t;
+
+        EINA_INARRAY_FOREACH(sd->common.ord, t)
+            evas_object_del(*t);
+        eina_inarray_free(sd->common.ord);
+        free(sd->lods);
+        free(sd->decimations);
+        free(sd->lod_x);
+        free(sd->lod_y);
+        free(sd->common.stack);
         evas_object_del(sd->common.bg);
         evas_object_del(sd->common.title);
         evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        evas_object_del(sd->common.overlay);
         free(sd);
     }
 }
@@ -261,12 +445,13 @@ static void
 _echart_line_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
     Evas_Coord ox;
     Evas_Coord oy;
     Evas_Coord dx;
     Evas_Coord dy;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -281,6 +466,17 @@ _echart_line_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
     evas_object_move(sd->common.title, ox + dx, oy + dy);
     evas_object_geometry_get(sd->common.vg, &ox, &oy, NULL, NULL);
     evas_object_move(sd->common.vg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.overlay, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.overlay, ox + dx, oy + dy);
+    sd->layout.left += dx;
+    sd->layout.top += dy;
+    EINA_INARRAY_FOREACH(sd->common.ord, t)
+    {
+        evas_object_geometry_get(*t, &ox, &oy, NULL, NULL);
+        evas_object_move(*t, ox + dx, oy + dy);
+    }
 }
 
 static void
@@ -288,29 +484,30 @@ _echart_line_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
-    /* FIXME: should do something here ? */
-
-    fprintf(stderr, " %s 2 : %dx%d\n", __FUNCTION__, w, h);
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
 }
 
 static void
 _echart_line_smart_show(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     evas_object_show(sd->common.bg);
     evas_object_show(sd->common.title);
-    evas_object_show(sd->common.vg);
+    EINA_INARRAY_FOREACH(sd->common.ord, t)
+        evas_object_show(*t);
+    echart_backend_set((Echart_Smart_Common *)sd, EINA_TRUE);
 
 }
 
@@ -318,50 +515,427 @@ static void
 _echart_line_smart_hide(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     evas_object_hide(sd->common.bg);
     evas_object_hide(sd->common.title);
+    EINA_INARRAY_FOREACH(sd->common.ord, t)
+        evas_object_hide(*t);
     evas_object_hide(sd->common.vg);
+    evas_object_hide(sd->common.img);
+    evas_object_hide(sd->common.overlay);
 }
 
 static void
 _echart_line_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     evas_object_clip_set(sd->common.bg, clip);
     evas_object_clip_set(sd->common.title, clip);
+    EINA_INARRAY_FOREACH(sd->common.ord, t)
+        evas_object_clip_set(*t, clip);
     evas_object_clip_set(sd->common.vg, clip);
+    evas_object_clip_set(sd->common.img, clip);
+    evas_object_clip_set(sd->common.overlay, clip);
 }
 
 static void
 _echart_line_smart_clip_unset(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     evas_object_clip_unset(sd->common.bg);
     evas_object_clip_unset(sd->common.title);
+    EINA_INARRAY_FOREACH(sd->common.ord, t)
+        evas_object_clip_unset(*t);
     evas_object_clip_unset(sd->common.vg);
+    evas_object_clip_unset(sd->common.img);
+    evas_object_clip_unset(sd->common.overlay);
 }
 
 
+/*
+ * Prepare the levels of detail of the series and the buffers of the
+ * decimated samples for columns pixels. Each serie has its own part of
+ * the buffers, as the raster backend draws them once all are recorded.
+ * The parts are sized for the largest number of columns met, so that
+ * the decimated samples stay in place when the object is resized.
+ */
+static Eina_Bool
+_echart_line_lod_begin(Echart_Smart_Data *sd,
+                       unsigned int nbr_series, unsigned int columns)
+{
+    unsigned int size;
+
+    if (nbr_series != sd->nbr_lods)
+    {
+        Echart_Lod *lods;
+        Echart_Line_Decimation *decimations;
+
+        lods = (Echart_Lod *)calloc(nbr_series, sizeof(Echart_Lod));
+        decimations = (Echart_Line_Decimation *)calloc(nbr_series, sizeof(Echart_Line_Decimation));
+        free(sd->lods);
+        free(sd->decimations);
+        if (!lods || !decimations)
+        {
+            free(lods);
+            free(decimations);
+            lods = NULL;
+            decimations = NULL;
+        }
+        sd->lods = lods;
+        sd->decimations = decimations;
+        sd->nbr_lods = lods ? nbr_series : 0;
+        if (!lods)
+            return EINA_FALSE;
+    }
+
+    if (columns > sd->lod_columns)
+    {
+        /* the parts of the buffers move */
+        memset(sd->decimations, 0, sd->nbr_lods * sizeof(Echart_Line_Decimation));
+        sd->lod_columns = columns;
+    }
+
+    size = nbr_series * 4 * (sd->lod_columns + 2);
+    if (size > sd->lod_size)
+    {
+        double *lod_x;
+        double *lod_y;
+
+        memset(sd->decimations, 0, sd->nbr_lods * sizeof(Echart_Line_Decimation));
+        lod_x = (double *)realloc(sd->lod_x, size * sizeof(double));
+        if (!lod_x)
+            return EINA_FALSE;
+        sd->lod_x = lod_x;
+        lod_y = (double *)realloc(sd->lod_y, size * sizeof(double));
+        if (!lod_y)
+            return EINA_FALSE;
+        sd->lod_y = lod_y;
+        sd->lod_size = size;
+    }
+
+    return EINA_TRUE;
+}
+
+/*
+ * Select the level of detail of the serie idx from its number of
+ * samples per pixel column, and fill p with the samples to draw.
+ * When the object has only been resized, the samples decimated in a
+ * previous frame are kept, as long as the level of detail does not
+ * change and the number of columns stays close to the one of the
+ * decimation: at most 2 samples per column, at least 4 columns for 5
+ * samples.
+ */
 static void
-_echart_line_smart_calculate(Evas_Object *obj)
+_echart_line_lod_apply(Echart_Smart_Data *sd,
+                       unsigned int idx,
+                       const double *xv, const double *yv,
+                       unsigned int first, unsigned int last,
+                       Eina_Bool sorted,
+                       double xmin, double xmax,
+                       unsigned int columns,
+                       Echart_Line_Points *p)
+{
+    Echart_Line_Decimation *d;
+    Echart_Lod lod;
+    unsigned int size;
+    unsigned int n;
+    double *lod_x;
+    double *lod_y;
+
+    p->xv = xv;
+    p->yv = yv;
+    p->first = first;
+    p->last = last;
+
+    /* the decimation needs a sorted absciss */
+    size = 4 * (sd->lod_columns + 2);
+    if ((idx >= sd->nbr_lods) || (sd->lod_size < sd->nbr_lods * size))
+        return;
+    lod_x = sd->lod_x + idx * size;
+    lod_y = sd->lod_y + idx * size;
+    d = sd->decimations + idx;
+
+    lod = ECHART_LOD_RAW;
+    if (sorted)
+        lod = echart_lod_select(sd->lods[idx], last - first + 1, columns);
+
+    if (sd->lod_reuse && d->nbr && (lod == sd->lods[idx]) &&
+        (d->xv == xv) && (d->yv == yv) &&
+        (d->first == first) && (d->last == last) &&
+        (d->xmin == xmin) && (d->xmax == xmax) &&
+        (2 * columns >= d->columns) && (4 * columns <= 5 * d->columns))
+    {
+        p->xv = lod_x;
+        p->yv = lod_y;
+        p->first = 0;
+        p->last = d->nbr - 1;
+        return;
+    }
+
+    sd->lods[idx] = lod;
+    d->nbr = 0;
+
+    if (lod == ECHART_LOD_RAW)
+        return;
+
+    if (lod == ECHART_LOD_DOWNSAMPLE)
+        n = echart_lod_downsample(xv, yv, first, last, columns,
+                                  lod_x, lod_y);
+    else
+        n = echart_lod_envelope(xv, yv, first, last, xmin, xmax, columns,
+                                lod_x, lod_y);
+    if (!n)
+        return;
+
+    d->xv = xv;
+    d->yv = yv;
+    d->first = first;
+    d->last = last;
+    d->xmin = xmin;
+    d->xmax = xmax;
+    d->columns = columns;
+    d->nbr = n;
+
+    p->xv = lod_x;
+    p->yv = lod_y;
+    p->first = 0;
+    p->last = n - 1;
+}
+
+static void
+_echart_line_ord_text_get(const void *data, unsigned int i,
+                          char *buf, size_t size)
+{
+    echart_scale_label_get((const Echart_Scale *)data, i, buf, size);
+}
+
+/*
+ * Labels of the ordinate, the text objects being reused from one
+ * calculation to the next one. With a dense grid, only one tick every
+ * stride ticks is labelled, so that the labels do not overlap.
+ */
+static void
+_echart_line_ord_set(Echart_Smart_Data *sd, Evas_Object *obj,
+                     double ymin, double ymax)
+{
+    Echart_Font_Style fs;
+    Echart_Offsets offsets;
+    Evas_Coord h_ord;
+    unsigned int stride;
+    unsigned int nbr;
+    int gyn;
+    int i;
+
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn <= 0)
+    {
+        echart_labels_count_set(sd->common.ord, 0);
+        return;
+    }
+
+    echart_offsets_get(sd->common.title, &offsets);
+    echart_chart_title_vaxis_style_get(sd->common.chart, &fs);
+    stride = echart_labels_stride_get(sd->common.ord, obj, &fs,
+                                      _echart_line_ord_text_get,
+                                      &sd->common.yscale,
+                                      0, gyn,
+                                      (double)(sd->common.h_vg - 1) / gyn,
+                                      EINA_TRUE);
+
+    nbr = 0;
+    for (i = 0; i <= gyn; i += stride)
+    {
+        char buf[128];
+        Evas_Object *o;
+        double y;
+        int j;
+
+        o = echart_label_object_get(sd->common.ord, obj, nbr++);
+
+        /* the ticks and their precision are cached in the scale */
+        y = echart_scale_tick_get(&sd->common.yscale, i);
+        echart_scale_label_get(&sd->common.yscale, i, buf, sizeof(buf));
+        echart_text_object_set(o, buf, &fs, NULL, &h_ord);
+
+        /* above the grid line, on the right of the axis */
+        j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+        evas_object_move(o, offsets.left + PAD(3), offsets.top + PAD(j) - h_ord);
+    }
+
+    echart_labels_count_set(sd->common.ord, nbr);
+}
+
+static void
+_echart_line_raster_draw(Echart_Smart_Data *sd,
+                         const Echart_Data *data,
+                         double xmin, double xmax,
+                         double ymin, double ymax)
+{
+    Echart_Raster r;
+    Echart_Raster_Transform t;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_List *series;
+    const Eina_List *l;
+    const Eina_Inarray *x_values;
+    const double *stack;
+    Echart_Line_Points prev;
+    unsigned int col;
+    unsigned int first;
+    unsigned int last;
+    unsigned int columns;
+    unsigned int idx;
+    double *xv;
+    int gyn;
+    Eina_Bool sorted;
+
+    if (!echart_raster_begin(&r, sd->common.img,
+                             sd->common.w_vg, sd->common.h_vg))
+        return;
+
+    echart_raster_clear(&r, 0x00000000);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+
+    /* axis */
+    echart_raster_rect_fill(&r,
+                            PAD(0), PAD(0),
+                            PAD(1), sd->common.h_vg - PAD(0),
+                            0xff000000);
+    echart_raster_rect_fill(&r,
+                            PAD(0), sd->common.h_vg - PAD(1),
+                            sd->common.w_vg - PAD(0), sd->common.h_vg - PAD(0),
+                            0xff000000);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        int i;
+
+        for (i = 1; i <= gyn; i++)
+        {
+            double y = i * (ymax - ymin) / gyn + ymin;
+            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            echart_raster_rect_fill(&r,
+                                    PAD(0.5), j + PAD(0),
+                                    sd->common.w_vg - PAD2(0.5), j + PAD(1),
+                                    col);
+        }
+    }
+
+    /* lines, only the visible part */
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+    absciss = echart_data_absciss_get(data);
+    x_values = echart_serie_values_get(absciss);
+    if (!x_values || !x_values->len)
+    {
+        echart_raster_end(&r, sd->common.img);
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+        return;
+    }
+
+    xv = (double *)x_values->members;
+    series = echart_data_series_get(data);
+    sorted = echart_serie_sorted_get(absciss);
+    echart_viewport_range_get(xv, x_values->len, sorted,
+                              xmin, xmax, &first, &last);
+
+    echart_raster_transform_set(&t,
+                                xmin, xmax,
+                                ymin, ymax,
+                                sd->common.padding, sd->common.padding,
+                                sd->common.w_vg - 2 * sd->common.padding,
+                                sd->common.h_vg - 2 * sd->common.padding);
+
+    columns = 1;
+    if (sd->common.w_vg > 2 * sd->common.padding)
+        columns = sd->common.w_vg - 2 * sd->common.padding;
+    _echart_line_lod_begin(sd, eina_list_count(series), columns);
+
+    stack = NULL;
+    if (echart_data_stacked_get(data))
+        stack = echart_stack_get((Echart_Smart_Common *)sd, series,
+                                 first, last);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+    idx = 0;
+    prev.xv = NULL;
+    EINA_LIST_FOREACH(series, l, serie)
+    {
+        const Eina_Inarray *y_values;
+        Echart_Line_Points p;
+        Echart_Colors cols;
+
+        y_values = echart_serie_values_get(serie);
+        idx++;
+        if (y_values->len < x_values->len)
+            continue;
+        cols = echart_serie_color_get(serie);
+
+        /* the stacked rows start at the first visible sample */
+        if (stack)
+            _echart_line_lod_apply(sd, idx - 1,
+                                   xv + first,
+                                   stack + (idx - 1) * (last - first + 1),
+                                   0, last - first, sorted,
+                                   xmin, xmax, columns, &p);
+        else
+            _echart_line_lod_apply(sd, idx - 1,
+                                   xv, (double *)y_values->members,
+                                   first, last, sorted,
+                                   xmin, xmax, columns, &p);
+        sd->common.stats.stats.points_in += last - first + 1;
+        sd->common.stats.stats.points_out += p.last - p.first + 1;
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+        echart_raster_polyline(&r, &t, p.xv, p.yv, p.first, p.last, sorted,
+                               2, cols.line);
+        if (echart_data_area_get(data))
+        {
+            unsigned int a;
+
+            a = 255 * echart_serie_opacity_get(serie);
+            /* a stacked area lies on the previous serie */
+            if (stack && prev.xv)
+                echart_raster_band(&r, &t, p.xv, p.yv, p.first, p.last, sorted,
+                                   prev.xv, prev.yv, prev.first, prev.last,
+                                   (a << 24) | (cols.area & 0x00ffffff));
+            else
+                echart_raster_area(&r, &t, p.xv, p.yv, p.first, p.last, sorted,
+                                   sd->common.h_vg - sd->common.padding - 1,
+                                   (a << 24) | (cols.area & 0x00ffffff));
+        }
+        prev = p;
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+    }
+
+    echart_raster_end(&r, sd->common.img);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+}
+
+static void
+_echart_line_layout_update(Evas_Object *obj, Echart_Smart_Data *sd)
 {
     const Echart_Data *data;
     const Echart_Serie *absciss;
@@ -369,26 +943,26 @@ _echart_line_smart_calculate(Evas_Object *obj)
     const Eina_List *series;
     const Eina_Inarray *x_values;
     const Eina_List *l;
-    Echart_Smart_Data *sd;
+    const double *stack;
+    Echart_Line_Points prev;
     unsigned int col;
+    unsigned int first;
+    unsigned int last;
+    unsigned int columns;
+    unsigned int idx;
     Efl_VG *line;
     double *xv;
+    double xmin;
+    double xmax;
     double ymin;
     double ymax;
     int gyn;
     int w;
     int h;
-    int n;
-    Echart_Offsets offsets;
-
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
-
-    sd = evas_object_smart_data_get(obj);
-    EINA_SAFETY_ON_NULL_RETURN(sd);
 
     sd->common.padding = 5;
 
-    echart_chart_size_get(sd->common.chart, &w, &h);
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
     col = echart_chart_background_color_get(sd->common.chart);
 
     /* background */
@@ -401,52 +975,41 @@ _echart_line_smart_calculate(Evas_Object *obj)
         Evas_Coord w_title;
 
         echart_chart_title_style_get(sd->common.chart, &fs);
-        _echart_text_object_set(sd->common.title,
-                                echart_chart_title_get(sd->common.chart),
-                                &fs);
-        evas_object_geometry_get(sd->common.title, NULL, NULL, &w_title, NULL);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
         evas_object_move(sd->common.title, (w - w_title) / 2, 0);
     }
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_BOUNDS);
+
+    /* vg */
+    echart_vg_set((Echart_Smart_Common *)sd);
+    echart_backend_set((Echart_Smart_Common *)sd, evas_object_visible_get(obj));
+    echart_vg_reset((Echart_Smart_Common *)sd);
+    sd->series_node = NULL;
+    sd->transformed = EINA_FALSE;
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
 
     data = echart_chart_data_get(sd->common.chart);
-    echart_data_interval_get(data, &ymin, &ymax);
-    n = (int)floor(log(ymax - ymin) / log(10));
-    ymax = (floor(ymax / pow(10, n - 1)) + 1) * pow(10, n - 1);
+    sd->layout.valid = EINA_FALSE;
+    if (!echart_viewport_get((Echart_Smart_Common *)sd,
+                             &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    _echart_line_layout_set(sd, data, xmin, xmax, ymin, ymax);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_BOUNDS);
 
     /* ordinate values */
-    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
-    if (gyn > 0)
-    {
-        Echart_Font_Style fs;
-        Evas_Coord w_ord;
-        int i;
+    _echart_line_ord_set(sd, obj, ymin, ymax);
+    sd->common.stats.stats.text_objects = 1 + eina_inarray_count(sd->common.ord);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_LABELS);
 
-        echart_chart_title_vaxis_style_get(sd->common.chart, &fs);
-        for (i = 0; i <=  gyn; i++)
-        {
-            char buf[128];
-            Evas_Object *t;
-            double y;
-            int j;
-
-            t = evas_object_text_add(evas_object_evas_get(obj));
-            snprintf(buf, sizeof(buf), "%d",
-                     (int)floor((ymax - ymin) * i / gyn + ymin));
-            buf[sizeof(buf) - 1] = '\0';
-            _echart_text_object_set(t, buf, &fs);
-            y = i * (ymax - ymin) / gyn + ymin;
-            j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
-            evas_object_geometry_get(t, NULL, NULL, &w_ord, NULL);
-            evas_object_move(t, 0/* (w - w_title) */, j);
-            eina_inarray_push(sd->common.ord, &t);
-        }
+    if (sd->common.backend == ECHART_BACKEND_RASTER)
+    {
+        _echart_line_raster_draw(sd, data, xmin, xmax, ymin, ymax);
+        return;
     }
 
-    echart_offsets_get(sd->common.title, &offsets);
-
-    /* vg */
-    echart_vg_set((Echart_Smart_Common *)sd);
-
     /* axis */
     line = evas_vg_shape_add(sd->common.root);
     evas_vg_shape_append_move_to(line, PAD(0.5), PAD(0.5));
@@ -481,38 +1044,90 @@ _echart_line_smart_calculate(Evas_Object *obj)
         }
     }
 
+    sd->common.stats.stats.vg_nodes = 1 + ((gyn > 0) ? gyn : 0);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+
+    /* only the samples in the window, and their neighbours, are drawn */
+    echart_viewport_range_get(xv, x_values->len,
+                              echart_serie_sorted_get(absciss),
+                              xmin, xmax, &first, &last);
+
+    columns = 1;
+    if (sd->common.w_vg > 2 * sd->common.padding)
+        columns = sd->common.w_vg - 2 * sd->common.padding;
+    _echart_line_lod_begin(sd, eina_list_count(series), columns);
+
+    stack = NULL;
+    if (echart_data_stacked_get(data))
+        stack = echart_stack_get((Echart_Smart_Common *)sd, series,
+                                 first, last);
+
+    /* the series are moved as a whole in interactive mode */
+    sd->series_node = evas_vg_container_add(sd->common.root);
+    sd->built.xmin = xmin;
+    sd->built.xmax = xmax;
+    sd->built.ymin = ymin;
+    sd->built.ymax = ymax;
+    sd->common.stats.stats.vg_nodes++;
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+    idx = 0;
+    prev.xv = NULL;
     EINA_LIST_FOREACH(series, l, serie)
     {
         const Eina_Inarray *y_values;
+        Echart_Line_Points p;
         Efl_VG *line_area;
         Echart_Colors cols;
-        double *yv;
         Evas_Coord x;
         Evas_Coord y;
-        int i;
+        Evas_Coord x_first;
+        unsigned int i;
 
         y_values = echart_serie_values_get(serie);
-        yv = (double *)y_values->members;
+        idx++;
+        if (y_values->len < x_values->len)
+            continue;
         cols = echart_serie_color_get(serie);
 
-        line = evas_vg_shape_add(sd->common.root);
+        if (stack)
+            _echart_line_lod_apply(sd, idx - 1,
+                                   xv + first,
+                                   stack + (idx - 1) * (last - first + 1),
+                                   0, last - first,
+                                   echart_serie_sorted_get(absciss),
+                                   xmin, xmax, columns, &p);
+        else
+            _echart_line_lod_apply(sd, idx - 1,
+                                   xv, (double *)y_values->members,
+                                   first, last,
+                                   echart_serie_sorted_get(absciss),
+                                   xmin, xmax, columns, &p);
+        sd->common.stats.stats.points_in += last - first + 1;
+        sd->common.stats.stats.points_out += p.last - p.first + 1;
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+        line = evas_vg_shape_add(sd->series_node);
+        sd->common.stats.stats.vg_nodes++;
         _echart_line_coords_get(sd,
-                                xv[0], xv[x_values->len - 1],
+                                xmin, xmax,
                                 ymin, ymax,
-                                xv[0], yv[0],
+                                p.xv[p.first], p.yv[p.first],
                                 &x, &y);
-        evas_vg_shape_append_move_to(line, x + 1, y);
+        x_first = x + 1;
+        evas_vg_shape_append_move_to(line, x_first, y);
         if (echart_data_area_get(data))
         {
-            line_area = evas_vg_shape_add(sd->common.root);
-            evas_vg_shape_append_move_to(line_area, x + 1, y);
+            line_area = evas_vg_shape_add(sd->series_node);
+            evas_vg_shape_append_move_to(line_area, x_first, y);
+            sd->common.stats.stats.vg_nodes++;
         }
-        for (i = 1; i < (int)x_values->len; i++)
+        for (i = p.first + 1; i <= p.last; i++)
         {
             _echart_line_coords_get(sd,
-                                    xv[0], xv[x_values->len - 1],
+                                    xmin, xmax,
                                     ymin, ymax,
-                                    xv[i], yv[i],
+                                    p.xv[i], p.yv[i],
                                     &x, &y);
             evas_vg_shape_append_line_to(line, x, y);
             if (echart_data_area_get(data))
@@ -530,8 +1145,24 @@ _echart_line_smart_calculate(Evas_Object *obj)
         {
             int a, r, g, b;
 
-            evas_vg_shape_append_line_to(line_area, sd->common.w_vg - sd->common.padding, sd->common.h_vg - sd->common.padding - 1);
-            evas_vg_shape_append_line_to(line_area, sd->common.padding + 1, sd->common.h_vg - sd->common.padding - 1);
+            if (stack && prev.xv)
+            {
+                /* back along the previous serie */
+                for (i = prev.last + 1; i > prev.first; i--)
+                {
+                    _echart_line_coords_get(sd,
+                                            xmin, xmax,
+                                            ymin, ymax,
+                                            prev.xv[i - 1], prev.yv[i - 1],
+                                            &x, &y);
+                    evas_vg_shape_append_line_to(line_area, x, y);
+                }
+            }
+            else
+            {
+                evas_vg_shape_append_line_to(line_area, x, sd->common.h_vg - sd->common.padding - 1);
+                evas_vg_shape_append_line_to(line_area, x_first, sd->common.h_vg - sd->common.padding - 1);
+            }
             evas_vg_shape_append_close(line_area);
             a = 255 * echart_serie_opacity_get(serie);
             r = ((COL_TO_R(cols.area) * a) >> 8);
@@ -539,7 +1170,108 @@ _echart_line_smart_calculate(Evas_Object *obj)
             b = ((COL_TO_B(cols.area) * a) >> 8);
             evas_vg_node_color_set(line_area, r, g, b, a);
         }
+        prev = p;
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+    }
+}
+
+/*
+ * In interactive mode, a change of the window only moves and scales the
+ * shapes of the series built for the window sd->built, so that a frame
+ * does not depend on the number of samples drawn. The ordinate labels
+ * and the layout of the hit-testing follow the new window.
+ */
+static void
+_echart_line_transform_update(Evas_Object *obj, Echart_Smart_Data *sd)
+{
+    Eina_Matrix3 m;
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    double w;
+    double h;
+    double sx;
+    double sy;
+
+    if (!echart_viewport_get((Echart_Smart_Common *)sd,
+                             &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    w = sd->common.w_vg - 2 * sd->common.padding;
+    h = sd->common.h_vg - 2 * sd->common.padding;
+    sx = (sd->built.xmax - sd->built.xmin) / (xmax - xmin);
+    sy = (sd->built.ymax - sd->built.ymin) / (ymax - ymin);
+    eina_matrix3_values_set(&m,
+                            sx, 0, sd->common.padding * (1 - sx) + w * (sd->built.xmin - xmin) / (xmax - xmin),
+                            0, sy, sd->common.padding * (1 - sy) + h * (ymax - sd->built.ymax) / (ymax - ymin),
+                            0, 0, 1);
+    evas_vg_node_transformation_set(sd->series_node, &m);
+    sd->transformed = EINA_TRUE;
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+    _echart_line_ord_set(sd, obj, ymin, ymax);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_LABELS);
+
+    sd->layout.xmin = xmin;
+    sd->layout.xmax = xmax;
+    sd->layout.ymin = ymin;
+    sd->layout.ymax = ymax;
+}
+
+/* a change of the window, the series being moved in interactive mode */
+static void
+_echart_line_window_changed(Echart_Smart_Data *sd, Evas_Object *obj)
+{
+    if (sd->interactive && sd->series_node && sd->layout.valid)
+    {
+        sd->need_transform = EINA_TRUE;
+        evas_object_smart_changed(obj);
+    }
+    else
+        echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+static void
+_echart_line_smart_calculate(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_stats_frame_begin(&sd->common.stats,
+                             sd->common.need_layout || sd->common.need_resize);
+
+    /* called once per frame, see echart_object_changed() */
+    if (sd->common.need_layout || sd->common.need_resize)
+    {
+        /* a resize alone keeps the decimated samples */
+        sd->lod_reuse = !sd->common.need_layout;
+        sd->common.need_layout = EINA_FALSE;
+        sd->common.need_resize = EINA_FALSE;
+        sd->need_transform = EINA_FALSE;
+        _echart_line_layout_update(obj, sd);
+        /* the hovered sample may have moved */
+        sd->common.pointer_changed = EINA_TRUE;
+    }
+    else if (sd->need_transform)
+    {
+        sd->need_transform = EINA_FALSE;
+        _echart_line_transform_update(obj, sd);
+        sd->common.pointer_changed = EINA_TRUE;
+    }
+
+    if (sd->common.pointer_changed)
+    {
+        sd->common.pointer_changed = EINA_FALSE;
+        _echart_line_pointer_update(sd);
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_HOVER);
     }
+
+    echart_stats_frame_end(&sd->common.stats);
 }
 
 static void
@@ -597,5 +1329,156 @@ echart_line_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
     INF("chart set");
 
     sd->common.chart = chart;
-    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_line_object_viewport_set(Evas_Object *obj,
+                                double xmin, double xmax,
+                                double ymin, double ymax)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    echart_viewport_set((Echart_Smart_Common *)sd, xmin, xmax, ymin, ymax);
+    _echart_line_window_changed(sd, obj);
+}
+
+EAPI void
+echart_line_object_viewport_get(const Evas_Object *obj,
+                                double *xmin, double *xmax,
+                                double *ymin, double *ymax)
+{
+    Echart_Smart_Data *sd;
+    double x0 = 0;
+    double x1 = 0;
+    double y0 = 0;
+    double y1 = 0;
+
+    if (xmin) *xmin = 0;
+    if (xmax) *xmax = 0;
+    if (ymin) *ymin = 0;
+    if (ymax) *ymax = 0;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    echart_viewport_get((Echart_Smart_Common *)sd, &x0, &x1, &y0, &y1);
+    if (xmin) *xmin = x0;
+    if (xmax) *xmax = x1;
+    if (ymin) *ymin = y0;
+    if (ymax) *ymax = y1;
+}
+
+EAPI void
+echart_line_object_viewport_reset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    echart_viewport_reset((Echart_Smart_Common *)sd);
+    _echart_line_window_changed(sd, obj);
+}
+
+EAPI void
+echart_line_object_pan(Evas_Object *obj, double dx, double dy)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    echart_viewport_pan((Echart_Smart_Common *)sd, dx, dy);
+    _echart_line_window_changed(sd, obj);
+}
+
+EAPI void
+echart_line_object_zoom(Evas_Object *obj, double factor, double x, double y)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    echart_viewport_zoom((Echart_Smart_Common *)sd, factor, x, y);
+    _echart_line_window_changed(sd, obj);
+}
+
+EAPI void
+echart_line_object_interactive_set(Evas_Object *obj, Eina_Bool interactive)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    interactive = !!interactive;
+    if (sd->interactive == interactive)
+        return;
+
+    sd->interactive = interactive;
+
+    /* the gesture is over, the series are decimated and built again */
+    if (!interactive && (sd->transformed || sd->need_transform))
+    {
+        sd->need_transform = EINA_FALSE;
+        echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+    }
+}
+
+EAPI Eina_Bool
+echart_line_object_interactive_get(const Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET_ERROR(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    return sd->interactive;
+
+  _err:
+    return EINA_FALSE;
+}
+
+EAPI Echart_Lod
+echart_line_object_lod_get(const Evas_Object *obj, unsigned int serie)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_LINE_SMART_OBJ_GET_ERROR(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    if (serie >= sd->nbr_lods)
+        return ECHART_LOD_RAW;
+
+    return sd->lods[serie];
+
+  _err:
+    return ECHART_LOD_RAW;
+}
+
+EAPI Eina_Bool
+echart_line_object_nearest_get(const Evas_Object *obj,
+                               Evas_Coord x, Evas_Coord y,
+                               const Echart_Serie **serie,
+                               unsigned int *index,
+                               double *value)
+{
+    Echart_Smart_Data *sd;
+    const Echart_Serie *s;
+    const Eina_Inarray *y_values;
+    Evas_Coord xd;
+    Evas_Coord yd;
+    unsigned int i;
+
+    ECHART_LINE_SMART_OBJ_GET_ERROR(sd, obj, ECHART_LINE_OBJ_NAME);
+
+    if (!_echart_line_nearest_get(sd, x, y, &s, &i, &xd, &yd))
+        return EINA_FALSE;
+
+    y_values = echart_serie_values_get(s);
+    if (serie) *serie = s;
+    if (index) *index = i;
+    if (value) *value = ((const double *)y_values->members)[i];
+
+    return EINA_TRUE;
+
+  _err:
+    return EINA_FALSE;
 }
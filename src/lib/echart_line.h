@@ -19,7 +19,46 @@
 #ifndef ECHART_LINE_H
 #define ECHART_LINE_H
 
+/* level of detail used to draw a serie */
+typedef enum
+{
+    ECHART_LOD_RAW,        /* all the samples */
+    ECHART_LOD_DOWNSAMPLE, /* shape preserving downsampling */
+    ECHART_LOD_ENVELOPE    /* min/max envelope of each pixel column */
+} Echart_Lod;
+
 EAPI Evas_Object *echart_line_object_add(Evas *evas);
 EAPI void echart_line_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
 
+EAPI void echart_line_object_viewport_set(Evas_Object *obj,
+                                          double xmin, double xmax,
+                                          double ymin, double ymax);
+EAPI void echart_line_object_viewport_get(const Evas_Object *obj,
+                                          double *xmin, double *xmax,
+                                          double *ymin, double *ymax);
+EAPI void echart_line_object_viewport_reset(Evas_Object *obj);
+EAPI void echart_line_object_pan(Evas_Object *obj, double dx, double dy);
+EAPI void echart_line_object_zoom(Evas_Object *obj, double factor, double x, double y);
+
+/*
+ * In interactive mode, for example during a drag, the changes of the
+ * window only move and scale the shapes already built, whatever the
+ * number of samples. The series are built again for the window when the
+ * mode is left. Only the VG backend is concerned.
+ */
+EAPI void echart_line_object_interactive_set(Evas_Object *obj, Eina_Bool interactive);
+EAPI Eina_Bool echart_line_object_interactive_get(const Evas_Object *obj);
+
+EAPI Echart_Lod echart_line_object_lod_get(const Evas_Object *obj, unsigned int serie);
+
+/*
+ * Sample of the serie drawn nearest to the canvas position (x, y),
+ * within a few pixels. value is the value of the serie, not stacked.
+ */
+EAPI Eina_Bool echart_line_object_nearest_get(const Evas_Object *obj,
+                                              Evas_Coord x, Evas_Coord y,
+                                              const Echart_Serie **serie,
+                                              unsigned int *index,
+                                              double *value);
+
 #endif /* ECHART_LINE_H */
@@ -0,0 +1,268 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_line.h"
+#include "echart_lod.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * Points per pixel column above which a level is selected. The level
+ * is only changed when the density is more than ECHART_LOD_HYSTERESIS
+ * away from the threshold, so that it does not flicker while zooming.
+ */
+#define ECHART_LOD_DOWNSAMPLE_PPP 1.0
+#define ECHART_LOD_ENVELOPE_PPP 4.0
+#define ECHART_LOD_HYSTERESIS 0.25
+
+static void
+_echart_lod_push(const double *xv, const double *yv, unsigned int i,
+                 double *xo, double *yo, unsigned int *n)
+{
+    xo[*n] = xv[i];
+    yo[*n] = yv[i];
+    (*n)++;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*
+ * Level of detail for nbr samples drawn on columns pixels, previous
+ * being the level used for the last frame.
+ */
+Echart_Lod
+echart_lod_select(Echart_Lod previous,
+                  unsigned int nbr, unsigned int columns)
+{
+    double ppp;
+    double down;
+    double env;
+
+    if (!columns)
+        return ECHART_LOD_RAW;
+
+    ppp = (double)nbr / columns;
+    down = ECHART_LOD_DOWNSAMPLE_PPP;
+    env = ECHART_LOD_ENVELOPE_PPP;
+
+    /* the thresholds around the previous level are moved away */
+    if (previous >= ECHART_LOD_DOWNSAMPLE)
+        down *= 1.0 - ECHART_LOD_HYSTERESIS;
+    else
+        down *= 1.0 + ECHART_LOD_HYSTERESIS;
+    if (previous == ECHART_LOD_ENVELOPE)
+        env *= 1.0 - ECHART_LOD_HYSTERESIS;
+    else
+        env *= 1.0 + ECHART_LOD_HYSTERESIS;
+
+    if (ppp > env)
+        return ECHART_LOD_ENVELOPE;
+    if (ppp > down)
+        return ECHART_LOD_DOWNSAMPLE;
+
+    return ECHART_LOD_RAW;
+}
+
+/*
+ * Largest-Triangle-Three-Buckets: keep threshold samples of [first, last]
+ * preserving the shape of the curve. xo and yo must hold threshold
+ * values. Returns the number of samples written.
+ */
+unsigned int
+echart_lod_downsample(const double *xv, const double *yv,
+                      unsigned int first, unsigned int last,
+                      unsigned int threshold,
+                      double *xo, double *yo)
+{
+    unsigned int nbr;
+    unsigned int n;
+    unsigned int a;
+    unsigned int i;
+    double every;
+
+    if (first > last)
+        return 0;
+
+    nbr = last - first + 1;
+    n = 0;
+    if ((threshold < 3) || (threshold >= nbr))
+    {
+        for (i = first; i <= last; i++)
+            _echart_lod_push(xv, yv, i, xo, yo, &n);
+        return n;
+    }
+
+    every = (double)(nbr - 2) / (threshold - 2);
+    a = first;
+    _echart_lod_push(xv, yv, a, xo, yo, &n);
+
+    for (i = 0; i < threshold - 2; i++)
+    {
+        unsigned int start;
+        unsigned int end;
+        unsigned int j;
+        unsigned int picked;
+        double xavg;
+        double yavg;
+        double area_max;
+
+        /* average of the next bucket */
+        start = first + (unsigned int)floor((i + 1) * every) + 1;
+        end = first + (unsigned int)floor((i + 2) * every) + 1;
+        if (end > last + 1)
+            end = last + 1;
+        if (start >= end)
+            start = end - 1;
+        xavg = 0;
+        yavg = 0;
+        for (j = start; j < end; j++)
+        {
+            xavg += xv[j];
+            yavg += yv[j];
+        }
+        xavg /= end - start;
+        yavg /= end - start;
+
+        /* point of the current bucket with the largest triangle */
+        start = first + (unsigned int)floor(i * every) + 1;
+        end = first + (unsigned int)floor((i + 1) * every) + 1;
+        picked = start;
+        area_max = -1;
+        for (j = start; j < end; j++)
+        {
+            double area;
+
+            area = fabs((xv[a] - xavg) * (yv[j] - yv[a]) -
+                        (xv[a] - xv[j]) * (yavg - yv[a]));
+            if (area > area_max)
+            {
+                area_max = area;
+                picked = j;
+            }
+        }
+
+        _echart_lod_push(xv, yv, picked, xo, yo, &n);
+        a = picked;
+    }
+
+    _echart_lod_push(xv, yv, last, xo, yo, &n);
+
+    return n;
+}
+
+/*
+ * Min/max envelope: for each of the columns pixels of [xmin, xmax], the
+ * first, minimum, maximum and last samples, in their order. Drawn as a
+ * line, it covers the same pixels as the whole serie. xo and yo must
+ * hold 4 * (columns + 2) values. Returns the number of samples written.
+ */
+unsigned int
+echart_lod_envelope(const double *xv, const double *yv,
+                    unsigned int first, unsigned int last,
+                    double xmin, double xmax,
+                    unsigned int columns,
+                    double *xo, double *yo)
+{
+    unsigned int n;
+    unsigned int i;
+    unsigned int c_first;
+    unsigned int c_min;
+    unsigned int c_max;
+    unsigned int c_last;
+    double scale;
+    long col;
+    long c;
+
+    n = 0;
+    if (first > last)
+        return 0;
+
+    /* an empty window is a single column */
+    scale = (xmax > xmin) ? columns / (xmax - xmin) : 0;
+    col = 0;
+    c_first = c_min = c_max = c_last = first;
+    for (i = first; i <= last + 1; i++)
+    {
+        if (i <= last)
+        {
+            /* the neighbours out of the window have their own column */
+            c = (long)floor((xv[i] - xmin) * scale);
+            if (c < 0)
+                c = -1;
+            else if (c >= (long)columns)
+                c = columns;
+
+            if (i == first)
+                col = c;
+
+            if (c == col)
+            {
+                if (yv[i] < yv[c_min])
+                    c_min = i;
+                if (yv[i] > yv[c_max])
+                    c_max = i;
+                c_last = i;
+                continue;
+            }
+        }
+
+        /* the column is finished */
+        _echart_lod_push(xv, yv, c_first, xo, yo, &n);
+        if ((c_min < c_max) && (c_min != c_first))
+            _echart_lod_push(xv, yv, c_min, xo, yo, &n);
+        if ((c_max != c_first) && (c_max != c_last))
+            _echart_lod_push(xv, yv, c_max, xo, yo, &n);
+        if ((c_min > c_max) && (c_min != c_last))
+            _echart_lod_push(xv, yv, c_min, xo, yo, &n);
+        if (c_last != c_first)
+            _echart_lod_push(xv, yv, c_last, xo, yo, &n);
+
+        if (i <= last)
+        {
+            col = c;
+            c_first = c_min = c_max = c_last = i;
+        }
+    }
+
+    return n;
+}
@@ -0,0 +1,36 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_LOD_H
+#define ECHART_LOD_H
+
+Echart_Lod echart_lod_select(Echart_Lod previous,
+                             unsigned int nbr, unsigned int columns);
+
+unsigned int echart_lod_downsample(const double *xv, const double *yv,
+                                   unsigned int first, unsigned int last,
+                                   unsigned int threshold,
+                                   double *xo, double *yo);
+
+unsigned int echart_lod_envelope(const double *xv, const double *yv,
+                                 unsigned int first, unsigned int last,
+                                 double xmin, double xmax,
+                                 unsigned int columns,
+                                 double *xo, double *yo);
+
+#endif /* ECHART_LOD_H */
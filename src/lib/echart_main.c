@@ -27,6 +27,11 @@
 
 #include "Echart.h"
 #include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_text.h"
+#include "echart_thread.h"
+#include "echart_trace.h"
 
 /*============================================================================*
  *                                  Local                                     *
@@ -78,8 +83,32 @@ echart_init(void)
         goto unregister_log_domain;
     }
 
+    if (!echart_trace_init())
+    {
+        ERR("Could not initialize the trace buffers.");
+        goto shutdown_evas;
+    }
+
+    if (!echart_thread_init())
+    {
+        ERR("Could not initialize the worker threads.");
+        goto shutdown_trace;
+    }
+
+    if (!echart_text_init())
+    {
+        ERR("Could not initialize the text cache.");
+        goto shutdown_thread;
+    }
+
     return _echart_init_count;
 
+  shutdown_thread:
+    echart_thread_shutdown();
+  shutdown_trace:
+    echart_trace_shutdown();
+  shutdown_evas:
+    evas_shutdown();
   unregister_log_domain:
     eina_log_domain_unregister(echart_log_dom_global);
     echart_log_dom_global = -1;
@@ -100,6 +129,9 @@ echart_shutdown(void)
     if (--_echart_init_count != 0)
         return _echart_init_count;
 
+    echart_text_shutdown();
+    echart_thread_shutdown();
+    echart_trace_shutdown();
     evas_shutdown();
     eina_log_domain_unregister(echart_log_dom_global);
     echart_log_dom_global = -1;
@@ -0,0 +1,188 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <Eina.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_ohlc.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+struct _Echart_Ohlc
+{
+    double interval;
+    Eina_Inarray *candles;
+    unsigned int ticks; /* ticks of the series already aggregated */
+};
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Echart_Ohlc *
+echart_ohlc_new(double interval)
+{
+    Echart_Ohlc *o;
+
+    if (!(interval > 0))
+    {
+        ERR("The interval of the candles must be positive");
+        return NULL;
+    }
+
+    o = (Echart_Ohlc *)calloc(1, sizeof(Echart_Ohlc));
+    if (!o)
+        return NULL;
+
+    o->candles = eina_inarray_new(sizeof(Echart_Ohlc_Candle), 64);
+    if (!o->candles)
+    {
+        free(o);
+        return NULL;
+    }
+
+    o->interval = interval;
+
+    return o;
+}
+
+EAPI void
+echart_ohlc_free(Echart_Ohlc *o)
+{
+    if (!o)
+        return;
+
+    eina_inarray_free(o->candles);
+    free(o);
+}
+
+EAPI void
+echart_ohlc_reset(Echart_Ohlc *o)
+{
+    if (!o)
+        return;
+
+    eina_inarray_flush(o->candles);
+    o->ticks = 0;
+}
+
+EAPI double
+echart_ohlc_interval_get(const Echart_Ohlc *o)
+{
+    return o ? o->interval : 0;
+}
+
+EAPI void
+echart_ohlc_tick_push(Echart_Ohlc *o, double t, double price)
+{
+    Echart_Ohlc_Candle candle;
+    Echart_Ohlc_Candle *c;
+    double start;
+
+    if (!o)
+        return;
+
+    start = floor(t / o->interval) * o->interval;
+    c = NULL;
+    if (o->candles->len)
+        c = (Echart_Ohlc_Candle *)o->candles->members + o->candles->len - 1;
+
+    if (c && (start <= c->t))
+    {
+        /* a late tick is folded in the last candle */
+        if (price > c->high) c->high = price;
+        if (price < c->low) c->low = price;
+        if (start == c->t)
+            c->close = price;
+        return;
+    }
+
+    candle.t = start;
+    candle.open = price;
+    candle.high = price;
+    candle.low = price;
+    candle.close = price;
+    if (eina_inarray_push(o->candles, &candle) < 0)
+        ERR("Could not add a candle.");
+}
+
+EAPI void
+echart_ohlc_series_update(Echart_Ohlc *o,
+                          const Echart_Serie *timestamps,
+                          const Echart_Serie *prices)
+{
+    const Eina_Inarray *tv;
+    const Eina_Inarray *pv;
+    const double *t;
+    const double *p;
+    unsigned int len;
+    unsigned int i;
+
+    if (!o || !timestamps || !prices)
+        return;
+
+    tv = echart_serie_values_get(timestamps);
+    pv = echart_serie_values_get(prices);
+    len = (tv->len < pv->len) ? tv->len : pv->len;
+
+    /* other series, all the ticks are aggregated again */
+    if (len < o->ticks)
+        echart_ohlc_reset(o);
+
+    t = (const double *)tv->members;
+    p = (const double *)pv->members;
+    for (i = o->ticks; i < len; i++)
+        echart_ohlc_tick_push(o, t[i], p[i]);
+
+    o->ticks = len;
+}
+
+EAPI const Echart_Ohlc_Candle *
+echart_ohlc_candles_get(const Echart_Ohlc *o, unsigned int *nbr)
+{
+    if (nbr) *nbr = 0;
+
+    if (!o || !o->candles->len)
+        return NULL;
+
+    if (nbr) *nbr = o->candles->len;
+
+    return (const Echart_Ohlc_Candle *)o->candles->members;
+}
@@ -0,0 +1,55 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_OHLC_H
+#define ECHART_OHLC_H
+
+/* prices of an interval starting at t */
+typedef struct
+{
+    double t;
+    double open;
+    double high;
+    double low;
+    double close;
+} Echart_Ohlc_Candle;
+
+typedef struct _Echart_Ohlc Echart_Ohlc;
+
+/*
+ * Aggregation of (timestamp, price) ticks in candles of interval
+ * seconds (or any unit of the timestamps). The ticks are expected in
+ * time order: a tick only updates the last candle or starts a new one.
+ */
+EAPI Echart_Ohlc *echart_ohlc_new(double interval);
+EAPI void echart_ohlc_free(Echart_Ohlc *o);
+EAPI void echart_ohlc_reset(Echart_Ohlc *o);
+EAPI double echart_ohlc_interval_get(const Echart_Ohlc *o);
+EAPI void echart_ohlc_tick_push(Echart_Ohlc *o, double t, double price);
+
+/*
+ * Push the ticks of the series that are not aggregated yet, so that
+ * calling it after each append only costs the appended ticks.
+ */
+EAPI void echart_ohlc_series_update(Echart_Ohlc *o,
+                                    const Echart_Serie *timestamps,
+                                    const Echart_Serie *prices);
+EAPI const Echart_Ohlc_Candle *echart_ohlc_candles_get(const Echart_Ohlc *o,
+                                                       unsigned int *nbr);
+
+#endif /* ECHART_OHLC_H */
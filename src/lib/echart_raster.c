@@ -0,0 +1,1252 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_thread.h"
+#include "echart_raster.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_RASTER_COORD_MAX 1073741824.0
+
+#define ECHART_RASTER_MARKER_MAX 16
+
+/* multiply the 4 components of c by a / 256, a in [0, 256] */
+static inline unsigned int
+_echart_raster_mul_256(unsigned int c, unsigned int a)
+{
+    return ((((c >> 8) & 0x00ff00ff) * a) & 0xff00ff00) +
+           ((((c & 0x00ff00ff) * a) >> 8) & 0x00ff00ff);
+}
+
+static inline unsigned int
+_echart_raster_premul(unsigned int col)
+{
+    unsigned int a;
+
+    a = col >> 24;
+
+    return (a << 24) | (_echart_raster_mul_256(col, a + 1) & 0x00ffffff);
+}
+
+/* src over, pcol premultiplied, cov in [0, 256] */
+static inline void
+_echart_raster_blend(unsigned int *p, unsigned int pcol, unsigned int cov)
+{
+    unsigned int s;
+
+    if (cov >= 256)
+    {
+        if ((pcol >> 24) == 0xff)
+        {
+            *p = pcol;
+            return;
+        }
+        s = pcol;
+    }
+    else
+        s = _echart_raster_mul_256(pcol, cov);
+
+    *p = s + _echart_raster_mul_256(*p, 256 - (s >> 24));
+}
+
+/* pixel column (or row) of a coordinate, safe for far away values */
+static inline int
+_echart_raster_cell(double v)
+{
+    if (v < -1.0)
+        return -1;
+    if (v > ECHART_RASTER_COORD_MAX)
+        return (int)ECHART_RASTER_COORD_MAX;
+
+    return (int)floor(v);
+}
+
+/* vertical span [y0, y1[ in column x, with horizontal coverage cov_x */
+static void
+_echart_raster_vspan(Echart_Raster *r, int x, double y0, double y1,
+                     unsigned int pcol, unsigned int cov_x)
+{
+    unsigned int *p;
+    double ys;
+    double ye;
+    int j;
+    int je;
+
+    if ((x < r->cx0) || (x >= r->cx1))
+        return;
+
+    if (y0 < r->cy0) y0 = r->cy0;
+    if (y1 > r->cy1) y1 = r->cy1;
+    if (y1 <= y0)
+        return;
+
+    j = (int)y0;
+    je = (int)ceil(y1);
+    p = r->data + j * r->stride + x;
+    for (; j < je; j++, p += r->stride)
+    {
+        ys = (y0 > j) ? y0 : j;
+        ye = (y1 < (j + 1)) ? y1 : (j + 1);
+        _echart_raster_blend(p, pcol,
+                             (unsigned int)((ye - ys) * cov_x + 0.5));
+    }
+}
+
+/* horizontal span [x0, x1[ in row y, with vertical coverage cov_y */
+static void
+_echart_raster_hspan(Echart_Raster *r, int y, double x0, double x1,
+                     unsigned int pcol, unsigned int cov_y)
+{
+    unsigned int *p;
+    double xs;
+    double xe;
+    int i;
+    int ie;
+
+    if ((y < r->cy0) || (y >= r->cy1))
+        return;
+
+    if (x0 < r->cx0) x0 = r->cx0;
+    if (x1 > r->cx1) x1 = r->cx1;
+    if (x1 <= x0)
+        return;
+
+    i = (int)x0;
+    ie = (int)ceil(x1);
+    p = r->data + y * r->stride + i;
+    for (; i < ie; i++, p++)
+    {
+        xs = (x0 > i) ? x0 : i;
+        xe = (x1 < (i + 1)) ? x1 : (i + 1);
+        _echart_raster_blend(p, pcol,
+                             (unsigned int)((xe - xs) * cov_y + 0.5));
+    }
+}
+
+/*
+ * anti-aliased segment of half width hw: an x-major segment is drawn
+ * as one vertical span per column, an y-major one as one horizontal
+ * span per row.
+ */
+static void
+_echart_raster_segment(Echart_Raster *r,
+                       double x0, double y0,
+                       double x1, double y1,
+                       double hw, unsigned int pcol)
+{
+    double dx;
+    double dy;
+    double slope;
+    double h;
+    double c;
+    double v;
+    int i;
+    int ie;
+
+    dx = x1 - x0;
+    dy = y1 - y0;
+
+    if (fabs(dx) >= fabs(dy))
+    {
+        if (dx < 0)
+        {
+            v = x0; x0 = x1; x1 = v;
+            v = y0; y0 = y1; y1 = v;
+            dx = -dx;
+            dy = -dy;
+        }
+
+        slope = (dx > 0) ? dy / dx : 0;
+        h = hw * sqrt(1 + slope * slope);
+        i = _echart_raster_cell(x0);
+        ie = _echart_raster_cell(x1);
+        if (i < r->cx0) i = r->cx0;
+        if (ie >= r->cx1) ie = r->cx1 - 1;
+        for (; i <= ie; i++)
+        {
+            c = i + 0.5;
+            if (c < x0) c = x0;
+            if (c > x1) c = x1;
+            v = y0 + (c - x0) * slope;
+            _echart_raster_vspan(r, i, v - h, v + h, pcol, 256);
+        }
+    }
+    else
+    {
+        if (dy < 0)
+        {
+            v = x0; x0 = x1; x1 = v;
+            v = y0; y0 = y1; y1 = v;
+            dx = -dx;
+            dy = -dy;
+        }
+
+        slope = dx / dy;
+        h = hw * sqrt(1 + slope * slope);
+        i = _echart_raster_cell(y0);
+        ie = _echart_raster_cell(y1);
+        if (i < r->cy0) i = r->cy0;
+        if (ie >= r->cy1) ie = r->cy1 - 1;
+        for (; i <= ie; i++)
+        {
+            c = i + 0.5;
+            if (c < y0) c = y0;
+            if (c > y1) c = y1;
+            v = x0 + (c - y0) * slope;
+            _echart_raster_hspan(r, i, v - h, v + h, pcol, 256);
+        }
+    }
+}
+
+static void
+_echart_raster_clear_draw(Echart_Raster *r, unsigned int col)
+{
+    unsigned int pcol;
+    int i;
+    int j;
+
+    if (!r->data)
+        return;
+
+    pcol = _echart_raster_premul(col);
+    for (j = r->cy0; j < r->cy1; j++)
+    {
+        unsigned int *p;
+
+        p = r->data + j * r->stride;
+        for (i = r->cx0; i < r->cx1; i++)
+            p[i] = pcol;
+    }
+}
+
+static void
+_echart_raster_rect_fill_draw(Echart_Raster *r,
+                              double x0, double y0,
+                              double x1, double y1,
+                              unsigned int col)
+{
+    unsigned int pcol;
+    double v;
+    double ys;
+    double ye;
+    int j;
+    int je;
+
+    if (!r->data)
+        return;
+
+    if (x1 < x0) { v = x0; x0 = x1; x1 = v; }
+    if (y1 < y0) { v = y0; y0 = y1; y1 = v; }
+    if (y0 < r->cy0) y0 = r->cy0;
+    if (y1 > r->cy1) y1 = r->cy1;
+    if (y1 <= y0)
+        return;
+
+    pcol = _echart_raster_premul(col);
+    j = (int)y0;
+    je = (int)ceil(y1);
+    for (; j < je; j++)
+    {
+        ys = (y0 > j) ? y0 : j;
+        ye = (y1 < (j + 1)) ? y1 : (j + 1);
+        _echart_raster_hspan(r, j, x0, x1, pcol,
+                             (unsigned int)((ye - ys) * 256 + 0.5));
+    }
+}
+
+/*
+ * Consecutive points that fall in the same pixel column are collapsed
+ * into a single vertical span covering their extent, so the cost of
+ * dense series is dominated by the transform of the points, not by the
+ * drawing.
+ */
+static void
+_echart_raster_polyline_draw(Echart_Raster *r,
+                             const Echart_Raster_Transform *t,
+                             const double *xv, const double *yv,
+                             size_t first, size_t last,
+                             double width, unsigned int col)
+{
+    unsigned int pcol;
+    double hw;
+    double px_prev;
+    double py_prev;
+    double px;
+    double py;
+    double ymin;
+    double ymax;
+    size_t i;
+    int cx;
+    int c;
+    Eina_Bool collapsed;
+
+    if (!r->data || (last < first))
+        return;
+
+    pcol = _echart_raster_premul(col);
+    hw = width / 2;
+
+    px_prev = t->ax * xv[first] + t->bx;
+    py_prev = t->ay * yv[first] + t->by;
+    if (first == last)
+    {
+        _echart_raster_segment(r, px_prev, py_prev, px_prev, py_prev,
+                               hw, pcol);
+        return;
+    }
+
+    cx = _echart_raster_cell(px_prev);
+    ymin = py_prev;
+    ymax = py_prev;
+    collapsed = EINA_FALSE;
+    for (i = first + 1; i <= last; i++)
+    {
+        px = t->ax * xv[i] + t->bx;
+        py = t->ay * yv[i] + t->by;
+        c = _echart_raster_cell(px);
+        if (c == cx)
+        {
+            if (py < ymin) ymin = py;
+            if (py > ymax) ymax = py;
+            collapsed = EINA_TRUE;
+        }
+        else
+        {
+            if (collapsed)
+                _echart_raster_vspan(r, cx, ymin - hw, ymax + hw, pcol, 256);
+            _echart_raster_segment(r, px_prev, py_prev, px, py, hw, pcol);
+            cx = c;
+            ymin = py;
+            ymax = py;
+            collapsed = EINA_FALSE;
+        }
+        px_prev = px;
+        py_prev = py;
+    }
+
+    if (collapsed)
+        _echart_raster_vspan(r, cx, ymin - hw, ymax + hw, pcol, 256);
+}
+
+/*
+ * Top of a curve in each column of the clip rectangle: the minimum of
+ * its points in the column and of its segments at the column center,
+ * HUGE_VAL if the curve is not in the column.
+ */
+static void
+_echart_raster_tops_get(const Echart_Raster *r,
+                        const Echart_Raster_Transform *t,
+                        const double *xv, const double *yv,
+                        size_t first, size_t last,
+                        double *tops)
+{
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+    size_t i;
+    int w;
+    int c;
+    int ce;
+
+    w = r->cx1 - r->cx0;
+    for (c = 0; c < w; c++)
+        tops[c] = HUGE_VAL;
+
+    x0 = t->ax * xv[first] + t->bx;
+    y0 = t->ay * yv[first] + t->by;
+    c = _echart_raster_cell(x0);
+    if ((c >= r->cx0) && (c < r->cx1) && (y0 < tops[c - r->cx0]))
+        tops[c - r->cx0] = y0;
+
+    for (i = first + 1; i <= last; i++)
+    {
+        x1 = t->ax * xv[i] + t->bx;
+        y1 = t->ay * yv[i] + t->by;
+
+        /* the point itself, to keep the peaks */
+        c = _echart_raster_cell(x1);
+        if ((c >= r->cx0) && (c < r->cx1) && (y1 < tops[c - r->cx0]))
+            tops[c - r->cx0] = y1;
+
+        /* the columns whose center is crossed by the segment */
+        if (x1 > x0)
+        {
+            double slope;
+
+            slope = (y1 - y0) / (x1 - x0);
+            c = _echart_raster_cell(x0 - 0.5);
+            if ((c + 0.5) < x0) c++;
+            ce = _echart_raster_cell(x1 + 0.5) - 1;
+            if (c < r->cx0) c = r->cx0;
+            if (ce >= r->cx1) ce = r->cx1 - 1;
+            for (; c <= ce; c++)
+            {
+                double y;
+
+                y = y0 + (c + 0.5 - x0) * slope;
+                if (y < tops[c - r->cx0])
+                    tops[c - r->cx0] = y;
+            }
+        }
+
+        x0 = x1;
+        y0 = y1;
+    }
+}
+
+/*
+ * The top of the area is first computed for each column of the clip
+ * rectangle, then each column is filled exactly once, so that
+ * translucent colors are not blended several times.
+ */
+static void
+_echart_raster_area_draw(Echart_Raster *r,
+                         const Echart_Raster_Transform *t,
+                         const double *xv, const double *yv,
+                         size_t first, size_t last,
+                         double base, unsigned int col)
+{
+    double *tops;
+    unsigned int pcol;
+    int w;
+    int c;
+
+    if (!r->data || (last < first) || (r->cx1 <= r->cx0))
+        return;
+
+    w = r->cx1 - r->cx0;
+    tops = (double *)malloc(w * sizeof(double));
+    if (!tops)
+        return;
+
+    _echart_raster_tops_get(r, t, xv, yv, first, last, tops);
+
+    pcol = _echart_raster_premul(col);
+    for (c = 0; c < w; c++)
+    {
+        if (tops[c] < base)
+            _echart_raster_vspan(r, r->cx0 + c, tops[c], base, pcol, 256);
+    }
+
+    free(tops);
+}
+
+/*
+ * Band between a curve and the one below it, as in a stacked area. The
+ * top of the lower curve is the bottom of the band, so that stacked
+ * bands share their borders without gap nor overlap. The lower curve is
+ * not binned in the tiles, it is expected to be decimated.
+ */
+static void
+_echart_raster_band_draw(Echart_Raster *r,
+                         const Echart_Raster_Transform *t,
+                         const double *xv, const double *yv,
+                         size_t first, size_t last,
+                         const double *bxv, const double *byv,
+                         size_t bfirst, size_t blast,
+                         unsigned int col)
+{
+    double *tops;
+    double *bottoms;
+    unsigned int pcol;
+    int w;
+    int c;
+
+    if (!r->data || (last < first) || (blast < bfirst) || (r->cx1 <= r->cx0))
+        return;
+
+    w = r->cx1 - r->cx0;
+    tops = (double *)malloc(2 * w * sizeof(double));
+    if (!tops)
+        return;
+    bottoms = tops + w;
+
+    _echart_raster_tops_get(r, t, xv, yv, first, last, tops);
+    _echart_raster_tops_get(r, t, bxv, byv, bfirst, blast, bottoms);
+
+    pcol = _echart_raster_premul(col);
+    for (c = 0; c < w; c++)
+    {
+        if ((tops[c] < bottoms[c]) && (bottoms[c] != HUGE_VAL))
+            _echart_raster_vspan(r, r->cx0 + c, tops[c], bottoms[c], pcol, 256);
+    }
+
+    free(tops);
+}
+
+/*
+ * The marker, an anti-aliased disc, is rendered once in a coverage mask
+ * which is then stamped at the pixel of each point.
+ */
+static void
+_echart_raster_markers_draw(Echart_Raster *r,
+                            const Echart_Raster_Transform *t,
+                            const double *xv, const double *yv,
+                            size_t first, size_t last,
+                            double radius, unsigned int col)
+{
+    unsigned short mask[(2 * ECHART_RASTER_MARKER_MAX + 1) *
+                        (2 * ECHART_RASTER_MARKER_MAX + 1)];
+    unsigned int pcol;
+    size_t k;
+    int rad;
+    int s;
+    int i;
+    int j;
+
+    if (radius > ECHART_RASTER_MARKER_MAX)
+        radius = ECHART_RASTER_MARKER_MAX;
+    if (radius < 0.5)
+        radius = 0.5;
+
+    rad = (int)ceil(radius);
+    s = 2 * rad + 1;
+    for (j = 0; j < s; j++)
+    {
+        for (i = 0; i < s; i++)
+        {
+            double c;
+
+            c = radius + 0.5 - sqrt((i - rad) * (i - rad) + (j - rad) * (j - rad));
+            if (c < 0) c = 0;
+            if (c > 1) c = 1;
+            mask[j * s + i] = (unsigned short)(c * 256 + 0.5);
+        }
+    }
+
+    pcol = _echart_raster_premul(col);
+    for (k = first; k <= last; k++)
+    {
+        const unsigned short *m;
+        unsigned int *p;
+        double px;
+        double py;
+        int cx;
+        int cy;
+        int i0;
+        int i1;
+        int j0;
+        int j1;
+
+        px = t->ax * xv[k] + t->bx;
+        py = t->ay * yv[k] + t->by;
+        if (!((px >= r->cx0 - rad - 1) && (px < r->cx1 + rad + 1) &&
+              (py >= r->cy0 - rad - 1) && (py < r->cy1 + rad + 1)))
+            continue;
+
+        cx = (int)floor(px);
+        cy = (int)floor(py);
+        i0 = (cx - rad < r->cx0) ? r->cx0 : cx - rad;
+        i1 = (cx + rad + 1 > r->cx1) ? r->cx1 : cx + rad + 1;
+        j0 = (cy - rad < r->cy0) ? r->cy0 : cy - rad;
+        j1 = (cy + rad + 1 > r->cy1) ? r->cy1 : cy + rad + 1;
+        for (j = j0; j < j1; j++)
+        {
+            p = r->data + j * r->stride;
+            m = mask + (j - cy + rad) * s - (cx - rad);
+            for (i = i0; i < i1; i++)
+            {
+                if (m[i])
+                    _echart_raster_blend(p + i, pcol, m[i]);
+            }
+        }
+    }
+}
+
+/*
+ * Density of the points: counts of points per pixel, the opacity of a
+ * pixel growing with the logarithm of its count.
+ */
+static void
+_echart_raster_density_draw(Echart_Raster *r,
+                            const unsigned int *counts, unsigned int max,
+                            unsigned int col)
+{
+    unsigned int pcol;
+    double scale;
+    int i;
+    int j;
+
+    if (!max)
+        return;
+
+    pcol = _echart_raster_premul(col);
+    scale = 256.0 / log(1.0 + max);
+    for (j = r->cy0; j < r->cy1; j++)
+    {
+        const unsigned int *c;
+        unsigned int *p;
+
+        c = counts + j * r->w;
+        p = r->data + j * r->stride;
+        for (i = r->cx0; i < r->cx1; i++)
+        {
+            if (c[i])
+                _echart_raster_blend(p + i, pcol,
+                                     (unsigned int)(log(1.0 + c[i]) * scale + 0.5));
+        }
+    }
+}
+
+static unsigned int *
+_echart_raster_density_count(const Echart_Raster *r,
+                             const Echart_Raster_Transform *t,
+                             const double *xv, const double *yv,
+                             size_t first, size_t last,
+                             unsigned int *max)
+{
+    unsigned int *counts;
+    size_t k;
+
+    *max = 0;
+    counts = (unsigned int *)calloc(r->w * r->h, sizeof(unsigned int));
+    if (!counts)
+    {
+        ERR("Could not allocate the density counts.");
+        return NULL;
+    }
+
+    for (k = first; k <= last; k++)
+    {
+        double px;
+        double py;
+        unsigned int c;
+
+        px = t->ax * xv[k] + t->bx;
+        py = t->ay * yv[k] + t->by;
+        if (!((px >= 0) && (px < r->w) && (py >= 0) && (py < r->h)))
+            continue;
+
+        c = ++counts[(int)py * r->w + (int)px];
+        if (c > *max)
+            *max = c;
+    }
+
+    return counts;
+}
+
+/*
+ * Between echart_raster_begin() and echart_raster_end(), the drawing
+ * functions only record commands. When the buffer is finished, the
+ * commands are binned in vertical tiles and the tiles are drawn in
+ * parallel, each one clipped to its own columns, so that they can be
+ * written in the final buffer without any lock. Tiles are full height
+ * because the series are sorted by abscissa: the part of a serie that
+ * is in a tile is an index range found by binary search, and each point
+ * is transformed by one tile only.
+ */
+
+#define ECHART_RASTER_TILE_W_MIN 64
+
+typedef enum
+{
+    ECHART_RASTER_CMD_CLEAR,
+    ECHART_RASTER_CMD_RECT,
+    ECHART_RASTER_CMD_POLYLINE,
+    ECHART_RASTER_CMD_AREA,
+    ECHART_RASTER_CMD_BAND,
+    ECHART_RASTER_CMD_MARKERS,
+    ECHART_RASTER_CMD_DENSITY
+} Echart_Raster_Cmd_Type;
+
+typedef struct
+{
+    Echart_Raster_Cmd_Type type;
+    unsigned int col;
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+    Echart_Raster_Transform t;
+    const double *xv;
+    const double *yv;
+    size_t first;
+    size_t last;
+    const double *bxv; /* lower curve of a band */
+    const double *byv;
+    size_t bfirst;
+    size_t blast;
+    double param; /* line width, area base or marker radius */
+    unsigned int *counts; /* density, owned by the command */
+    unsigned int max;
+    Eina_Bool sorted;
+} Echart_Raster_Cmd;
+
+typedef struct
+{
+    unsigned int cmd;
+    size_t first;
+    size_t last;
+} Echart_Raster_Bin;
+
+typedef struct
+{
+    const Echart_Raster *r;
+    const Echart_Raster_Cmd *cmds;
+    Eina_Inarray **bins;
+    int tile_w;
+} Echart_Raster_Tiles;
+
+static void
+_echart_raster_cmd_draw(Echart_Raster *r, const Echart_Raster_Cmd *cmd,
+                        size_t first, size_t last)
+{
+    switch (cmd->type)
+    {
+        case ECHART_RASTER_CMD_CLEAR:
+            _echart_raster_clear_draw(r, cmd->col);
+            break;
+        case ECHART_RASTER_CMD_RECT:
+            _echart_raster_rect_fill_draw(r,
+                                          cmd->x0, cmd->y0, cmd->x1, cmd->y1,
+                                          cmd->col);
+            break;
+        case ECHART_RASTER_CMD_POLYLINE:
+            _echart_raster_polyline_draw(r, &cmd->t, cmd->xv, cmd->yv,
+                                         first, last,
+                                         cmd->param, cmd->col);
+            break;
+        case ECHART_RASTER_CMD_AREA:
+            _echart_raster_area_draw(r, &cmd->t, cmd->xv, cmd->yv,
+                                     first, last,
+                                     cmd->param, cmd->col);
+            break;
+        case ECHART_RASTER_CMD_BAND:
+            _echart_raster_band_draw(r, &cmd->t, cmd->xv, cmd->yv,
+                                     first, last,
+                                     cmd->bxv, cmd->byv,
+                                     cmd->bfirst, cmd->blast,
+                                     cmd->col);
+            break;
+        case ECHART_RASTER_CMD_MARKERS:
+            _echart_raster_markers_draw(r, &cmd->t, cmd->xv, cmd->yv,
+                                        first, last,
+                                        cmd->param, cmd->col);
+            break;
+        case ECHART_RASTER_CMD_DENSITY:
+            _echart_raster_density_draw(r, cmd->counts, cmd->max, cmd->col);
+            break;
+    }
+}
+
+/* first index in [first, last + 1[ whose value is >= v */
+static size_t
+_echart_raster_lower_bound(const double *xv, size_t first, size_t last, double v)
+{
+    size_t end;
+
+    end = last + 1;
+    while (first < end)
+    {
+        size_t mid;
+
+        mid = first + (end - first) / 2;
+        if (xv[mid] < v)
+            first = mid + 1;
+        else
+            end = mid;
+    }
+
+    return first;
+}
+
+/* first index in [first, last + 1[ whose value is > v */
+static size_t
+_echart_raster_upper_bound(const double *xv, size_t first, size_t last, double v)
+{
+    size_t end;
+
+    end = last + 1;
+    while (first < end)
+    {
+        size_t mid;
+
+        mid = first + (end - first) / 2;
+        if (xv[mid] <= v)
+            first = mid + 1;
+        else
+            end = mid;
+    }
+
+    return first;
+}
+
+/*
+ * Part of the command cmd that is in the columns [x0, x1[. Returns
+ * EINA_FALSE if it does not touch them.
+ */
+static Eina_Bool
+_echart_raster_cmd_bin(const Echart_Raster_Cmd *cmd, int x0, int x1,
+                       Echart_Raster_Bin *bin)
+{
+    double margin;
+    double xa;
+    double xb;
+    size_t lo;
+    size_t hi;
+
+    bin->first = cmd->first;
+    bin->last = cmd->last;
+
+    switch (cmd->type)
+    {
+        case ECHART_RASTER_CMD_CLEAR:
+        case ECHART_RASTER_CMD_DENSITY:
+            return EINA_TRUE;
+        case ECHART_RASTER_CMD_RECT:
+            return !((cmd->x0 >= x1 && cmd->x1 >= x1) ||
+                     (cmd->x0 < x0 && cmd->x1 < x0));
+        case ECHART_RASTER_CMD_POLYLINE:
+            margin = cmd->param / 2 + 1;
+            break;
+        case ECHART_RASTER_CMD_MARKERS:
+            margin = cmd->param + 1;
+            break;
+        default:
+            margin = 1;
+            break;
+    }
+
+    if (!cmd->sorted || (cmd->t.ax == 0))
+        return EINA_TRUE;
+
+    /* abscissa interval of the columns, with the line width */
+    xa = (x0 - margin - cmd->t.bx) / cmd->t.ax;
+    xb = (x1 + margin - cmd->t.bx) / cmd->t.ax;
+    if (xb < xa)
+    {
+        double v;
+
+        v = xa; xa = xb; xb = v;
+    }
+
+    lo = _echart_raster_lower_bound(cmd->xv, cmd->first, cmd->last, xa);
+    hi = _echart_raster_upper_bound(cmd->xv, cmd->first, cmd->last, xb);
+    if ((lo > cmd->last) || (hi == cmd->first))
+        return EINA_FALSE;
+
+    /* keep one neighbour on each side for the crossing segments */
+    bin->first = (lo > cmd->first) ? lo - 1 : cmd->first;
+    bin->last = (hi <= cmd->last) ? hi : cmd->last;
+
+    return EINA_TRUE;
+}
+
+static void
+_echart_raster_tile_job(void *data, unsigned int idx)
+{
+    Echart_Raster_Tiles *tiles;
+    Echart_Raster tile;
+    Echart_Raster_Bin *bin;
+
+    tiles = data;
+
+    tile = *tiles->r;
+    tile.cmds = NULL;
+    tile.cx0 = tiles->r->cx0 + idx * tiles->tile_w;
+    tile.cx1 = tile.cx0 + tiles->tile_w;
+    if (tile.cx1 > tiles->r->cx1)
+        tile.cx1 = tiles->r->cx1;
+
+    EINA_INARRAY_FOREACH(tiles->bins[idx], bin)
+        _echart_raster_cmd_draw(&tile, tiles->cmds + bin->cmd,
+                                bin->first, bin->last);
+}
+
+static void
+_echart_raster_cmds_flush(Echart_Raster *r)
+{
+    Echart_Raster_Tiles tiles;
+    Echart_Raster_Cmd *cmds;
+    unsigned int nbr_cmds;
+    unsigned int nbr_tiles;
+    unsigned int i;
+    unsigned int j;
+    int w;
+
+    cmds = (Echart_Raster_Cmd *)r->cmds->members;
+    nbr_cmds = eina_inarray_count(r->cmds);
+    w = r->cx1 - r->cx0;
+    if (!nbr_cmds || (w <= 0))
+        return;
+
+    nbr_tiles = 4 * echart_thread_count();
+    if (nbr_tiles > (unsigned int)(w / ECHART_RASTER_TILE_W_MIN))
+        nbr_tiles = w / ECHART_RASTER_TILE_W_MIN;
+
+    if (nbr_tiles <= 1)
+    {
+        for (i = 0; i < nbr_cmds; i++)
+            _echart_raster_cmd_draw(r, cmds + i, cmds[i].first, cmds[i].last);
+        return;
+    }
+
+    tiles.r = r;
+    tiles.cmds = cmds;
+    tiles.tile_w = (w + nbr_tiles - 1) / nbr_tiles;
+    nbr_tiles = (w + tiles.tile_w - 1) / tiles.tile_w;
+    tiles.bins = (Eina_Inarray **)calloc(nbr_tiles, sizeof(Eina_Inarray *));
+    if (!tiles.bins)
+        return;
+
+    for (j = 0; j < nbr_tiles; j++)
+    {
+        int x0;
+
+        tiles.bins[j] = eina_inarray_new(sizeof(Echart_Raster_Bin), nbr_cmds);
+        if (!tiles.bins[j])
+            goto free_bins;
+
+        x0 = r->cx0 + j * tiles.tile_w;
+        for (i = 0; i < nbr_cmds; i++)
+        {
+            Echart_Raster_Bin bin;
+
+            bin.cmd = i;
+            if (_echart_raster_cmd_bin(cmds + i, x0, x0 + tiles.tile_w, &bin))
+                eina_inarray_push(tiles.bins[j], &bin);
+        }
+    }
+
+    echart_thread_run(nbr_tiles, _echart_raster_tile_job, &tiles);
+
+  free_bins:
+    for (j = 0; j < nbr_tiles; j++)
+    {
+        if (tiles.bins[j])
+            eina_inarray_free(tiles.bins[j]);
+    }
+    free(tiles.bins);
+}
+
+static void
+_echart_raster_cmd_add(Echart_Raster *r, const Echart_Raster_Cmd *cmd)
+{
+    if (eina_inarray_push(r->cmds, cmd) < 0)
+        ERR("Could not record a drawing command.");
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+Eina_Bool
+echart_raster_begin(Echart_Raster *r, Evas_Object *img, int w, int h)
+{
+    r->data = NULL;
+    r->cmds = NULL;
+    if ((w <= 0) || (h <= 0))
+        return EINA_FALSE;
+
+    evas_object_image_colorspace_set(img, EVAS_COLORSPACE_ARGB8888);
+    evas_object_image_alpha_set(img, EINA_TRUE);
+    evas_object_image_size_set(img, w, h);
+    r->data = (unsigned int *)evas_object_image_data_get(img, EINA_TRUE);
+    if (!r->data)
+    {
+        ERR("Could not get the image data for writing.");
+        return EINA_FALSE;
+    }
+
+    r->w = w;
+    r->h = h;
+    r->stride = evas_object_image_stride_get(img) / 4;
+    r->cx0 = 0;
+    r->cy0 = 0;
+    r->cx1 = w;
+    r->cy1 = h;
+    r->cmds = eina_inarray_new(sizeof(Echart_Raster_Cmd), 16);
+
+    return EINA_TRUE;
+}
+
+void
+echart_raster_end(Echart_Raster *r, Evas_Object *img)
+{
+    if (!r->data)
+        return;
+
+    if (r->cmds)
+    {
+        Echart_Raster_Cmd *cmd;
+
+        _echart_raster_cmds_flush(r);
+        EINA_INARRAY_FOREACH(r->cmds, cmd)
+            free(cmd->counts);
+        eina_inarray_free(r->cmds);
+        r->cmds = NULL;
+    }
+
+    evas_object_image_data_set(img, r->data);
+    evas_object_image_data_update_add(img, 0, 0, r->w, r->h);
+    r->data = NULL;
+}
+
+void
+echart_raster_transform_set(Echart_Raster_Transform *t,
+                            double xmin, double xmax,
+                            double ymin, double ymax,
+                            double x, double y,
+                            double w, double h)
+{
+    t->ax = w / (xmax - xmin);
+    t->bx = x - t->ax * xmin;
+    t->ay = -h / (ymax - ymin);
+    t->by = y - t->ay * ymax;
+}
+
+void
+echart_raster_clear(Echart_Raster *r, unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data)
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_clear_draw(r, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_CLEAR;
+    cmd.col = col;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+void
+echart_raster_rect_fill(Echart_Raster *r,
+                        double x0, double y0,
+                        double x1, double y1,
+                        unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data)
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_rect_fill_draw(r, x0, y0, x1, y1, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_RECT;
+    cmd.col = col;
+    cmd.x0 = x0;
+    cmd.y0 = y0;
+    cmd.x1 = x1;
+    cmd.y1 = y1;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+void
+echart_raster_polyline(Echart_Raster *r,
+                       const Echart_Raster_Transform *t,
+                       const double *xv, const double *yv,
+                       size_t first, size_t last, Eina_Bool sorted,
+                       double width, unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data || (last < first))
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_polyline_draw(r, t, xv, yv, first, last, width, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_POLYLINE;
+    cmd.col = col;
+    cmd.t = *t;
+    cmd.xv = xv;
+    cmd.yv = yv;
+    cmd.first = first;
+    cmd.last = last;
+    cmd.param = width;
+    cmd.sorted = sorted;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+void
+echart_raster_area(Echart_Raster *r,
+                   const Echart_Raster_Transform *t,
+                   const double *xv, const double *yv,
+                   size_t first, size_t last, Eina_Bool sorted,
+                   double base, unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data || (last < first))
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_area_draw(r, t, xv, yv, first, last, base, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_AREA;
+    cmd.col = col;
+    cmd.t = *t;
+    cmd.xv = xv;
+    cmd.yv = yv;
+    cmd.first = first;
+    cmd.last = last;
+    cmd.param = base;
+    cmd.sorted = sorted;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+void
+echart_raster_band(Echart_Raster *r,
+                   const Echart_Raster_Transform *t,
+                   const double *xv, const double *yv,
+                   size_t first, size_t last, Eina_Bool sorted,
+                   const double *bxv, const double *byv,
+                   size_t bfirst, size_t blast,
+                   unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data || (last < first) || (blast < bfirst))
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_band_draw(r, t, xv, yv, first, last,
+                                 bxv, byv, bfirst, blast, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_BAND;
+    cmd.col = col;
+    cmd.t = *t;
+    cmd.xv = xv;
+    cmd.yv = yv;
+    cmd.first = first;
+    cmd.last = last;
+    cmd.bxv = bxv;
+    cmd.byv = byv;
+    cmd.bfirst = bfirst;
+    cmd.blast = blast;
+    cmd.sorted = sorted;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+void
+echart_raster_markers(Echart_Raster *r,
+                      const Echart_Raster_Transform *t,
+                      const double *xv, const double *yv,
+                      size_t first, size_t last, Eina_Bool sorted,
+                      double radius, unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+
+    if (!r->data || (last < first))
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_markers_draw(r, t, xv, yv, first, last, radius, col);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_MARKERS;
+    cmd.col = col;
+    cmd.t = *t;
+    cmd.xv = xv;
+    cmd.yv = yv;
+    cmd.first = first;
+    cmd.last = last;
+    cmd.param = radius;
+    cmd.sorted = sorted;
+    _echart_raster_cmd_add(r, &cmd);
+}
+
+/*
+ * The points are counted when the command is recorded, as the opacity
+ * depends on the maximum count of the whole buffer, then the tiles only
+ * draw their part of the counts.
+ */
+void
+echart_raster_density(Echart_Raster *r,
+                      const Echart_Raster_Transform *t,
+                      const double *xv, const double *yv,
+                      size_t first, size_t last,
+                      unsigned int col)
+{
+    Echart_Raster_Cmd cmd;
+    unsigned int *counts;
+    unsigned int max;
+
+    if (!r->data || (last < first))
+        return;
+
+    counts = _echart_raster_density_count(r, t, xv, yv, first, last, &max);
+    if (!counts)
+        return;
+
+    if (!r->cmds)
+    {
+        _echart_raster_density_draw(r, counts, max, col);
+        free(counts);
+        return;
+    }
+
+    memset(&cmd, 0, sizeof(Echart_Raster_Cmd));
+    cmd.type = ECHART_RASTER_CMD_DENSITY;
+    cmd.col = col;
+    cmd.counts = counts;
+    cmd.max = max;
+    if (eina_inarray_push(r->cmds, &cmd) < 0)
+    {
+        ERR("Could not record a drawing command.");
+        free(counts);
+    }
+}
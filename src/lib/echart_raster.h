@@ -0,0 +1,101 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_RASTER_H
+#define ECHART_RASTER_H
+
+#include <Eina.h>
+#include <Evas.h>
+
+/*
+ * ARGB32 (premultiplied) buffer, as used by the Evas image objects.
+ * Only the pixels inside the clip rectangle [cx0, cx1[ x [cy0, cy1[
+ * are ever written.
+ */
+typedef struct
+{
+    unsigned int *data;
+    int w;
+    int h;
+    int stride; /* in pixels */
+    int cx0;
+    int cy0;
+    int cx1;
+    int cy1;
+    Eina_Inarray *cmds; /* recorded commands, NULL to draw immediately */
+} Echart_Raster;
+
+/* data to pixel transform : px = ax * x + bx, py = ay * y + by */
+typedef struct
+{
+    double ax;
+    double bx;
+    double ay;
+    double by;
+} Echart_Raster_Transform;
+
+Eina_Bool echart_raster_begin(Echart_Raster *r, Evas_Object *img, int w, int h);
+
+void echart_raster_end(Echart_Raster *r, Evas_Object *img);
+
+void echart_raster_transform_set(Echart_Raster_Transform *t,
+                                 double xmin, double xmax,
+                                 double ymin, double ymax,
+                                 double x, double y,
+                                 double w, double h);
+
+void echart_raster_clear(Echart_Raster *r, unsigned int col);
+
+void echart_raster_rect_fill(Echart_Raster *r,
+                             double x0, double y0,
+                             double x1, double y1,
+                             unsigned int col);
+
+void echart_raster_polyline(Echart_Raster *r,
+                            const Echart_Raster_Transform *t,
+                            const double *xv, const double *yv,
+                            size_t first, size_t last, Eina_Bool sorted,
+                            double width, unsigned int col);
+
+void echart_raster_area(Echart_Raster *r,
+                        const Echart_Raster_Transform *t,
+                        const double *xv, const double *yv,
+                        size_t first, size_t last, Eina_Bool sorted,
+                        double base, unsigned int col);
+
+void echart_raster_band(Echart_Raster *r,
+                        const Echart_Raster_Transform *t,
+                        const double *xv, const double *yv,
+                        size_t first, size_t last, Eina_Bool sorted,
+                        const double *bxv, const double *byv,
+                        size_t bfirst, size_t blast,
+                        unsigned int col);
+
+void echart_raster_markers(Echart_Raster *r,
+                           const Echart_Raster_Transform *t,
+                           const double *xv, const double *yv,
+                           size_t first, size_t last, Eina_Bool sorted,
+                           double radius, unsigned int col);
+
+void echart_raster_density(Echart_Raster *r,
+                           const Echart_Raster_Transform *t,
+                           const double *xv, const double *yv,
+                           size_t first, size_t last,
+                           unsigned int col);
+
+#endif /* ECHART_RASTER_H */
@@ -0,0 +1,268 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <math.h>
+
+#include <Eina.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_scale.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/* pixels between two ticks when their number is not given */
+#define ECHART_SCALE_SPACING 48
+
+#define ECHART_SCALE_DECIMALS_MAX 9
+
+/* steps tried before giving up the nice ticks, 4 decades */
+#define ECHART_SCALE_NICE_STEPS_MAX 40
+
+/* width of an empty range, relative to its bounds */
+#define ECHART_SCALE_WIDTH_MIN 1e-9
+
+/* mantissas of the steps, the last one being the next decade */
+static const double _echart_scale_mantissas[] =
+{
+    1, 1.5, 2, 2.5, 3, 4, 5, 6, 8, 10
+};
+
+static const double _echart_scale_pow10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+/*
+ * Smallest nice step, a mantissa times a power of 10, such that nbr
+ * steps from a multiple of the step below min reach max. Returns
+ * EINA_FALSE if none is found, the range being too small for the
+ * precision of its bounds.
+ */
+static Eina_Bool
+_echart_scale_nice(Echart_Scale *s, double min, double max, unsigned int nbr)
+{
+    double e;
+    double step;
+    unsigned int i;
+    unsigned int k;
+
+    e = pow(10, floor(log10((max - min) / nbr)));
+    i = 0;
+    for (k = 0; k < ECHART_SCALE_NICE_STEPS_MAX; k++)
+    {
+        step = _echart_scale_mantissas[i] * e;
+        s->min = floor(min / step) * step;
+        if (s->min + nbr * step >= max)
+        {
+            s->step = step;
+            s->max = s->min + nbr * step;
+            return EINA_TRUE;
+        }
+        if (++i == sizeof(_echart_scale_mantissas) / sizeof(double))
+        {
+            e *= 10;
+            i = 0;
+        }
+    }
+
+    return EINA_FALSE;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/* decimals needed to write the multiples of step, whatever its sign */
+int
+echart_scale_decimals_get(double step)
+{
+    int d;
+
+    step = fabs(step);
+    if (step == 0)
+        return 0;
+
+    for (d = 0; d < ECHART_SCALE_DECIMALS_MAX; d++)
+    {
+        double v;
+
+        v = step * _echart_scale_pow10[d];
+        if (fabs(v - floor(v + 0.5)) < 1e-6 * v)
+            break;
+    }
+
+    return d;
+}
+
+/*
+ * Set the range [min, max] of an axis of length pixels, with nbr
+ * intervals between ticks, or one every ECHART_SCALE_SPACING pixels if
+ * nbr is not positive. If fixed is EINA_FALSE, the range is extended
+ * to nice ticks. NaN or infinite bounds give the fixed range [0, 1].
+ */
+void
+echart_scale_set(Echart_Scale *s,
+                 double min, double max,
+                 int nbr, int length,
+                 Eina_Bool fixed)
+{
+    unsigned int n;
+
+    if (s->valid &&
+        (s->vmin == min) && (s->vmax == max) &&
+        (s->nbr_req == nbr) && (s->length == length) &&
+        (s->fixed == !!fixed))
+        return;
+
+    s->vmin = min;
+    s->vmax = max;
+    s->nbr_req = nbr;
+    s->length = length;
+    s->fixed = !!fixed;
+    s->valid = EINA_TRUE;
+
+    /* NaN or infinite bounds, from a NaN sample for example */
+    if (!isfinite(min) || !isfinite(max))
+    {
+        min = 0;
+        max = 1;
+        fixed = EINA_TRUE;
+    }
+
+    /* an empty range is widened to be larger than the precision of min */
+    if (!(max > min))
+        max = min + fmax(1, fabs(min) * ECHART_SCALE_WIDTH_MIN);
+
+    if (nbr > 0)
+        n = nbr;
+    else
+    {
+        n = length / ECHART_SCALE_SPACING;
+        if (n < 1)
+            n = 1;
+    }
+
+    /* the width of the range can overflow, not the step */
+    if (!isfinite(max - min))
+    {
+        s->min = min;
+        s->max = max;
+        s->step = max / n - min / n;
+    }
+    else if (fixed || !_echart_scale_nice(s, min, max, n))
+    {
+        s->min = min;
+        s->max = max;
+        s->step = (max - min) / n;
+    }
+
+    s->nbr = n;
+    s->decimals = echart_scale_decimals_get(s->step);
+}
+
+double
+echart_scale_tick_get(const Echart_Scale *s, unsigned int i)
+{
+    if (i >= s->nbr)
+        return s->max;
+
+    return s->min + i * s->step;
+}
+
+size_t
+echart_scale_label_get(const Echart_Scale *s, unsigned int i,
+                       char *buf, size_t size)
+{
+    return echart_scale_format(echart_scale_tick_get(s, i), s->decimals,
+                               buf, size);
+}
+
+/*
+ * Write v with decimals digits after the point, with integer arithmetic
+ * only. The values out of the range of the integers use snprintf().
+ */
+size_t
+echart_scale_format(double v, int decimals, char *buf, size_t size)
+{
+    char tmp[32];
+    unsigned long long u;
+    size_t len;
+    size_t n;
+    int neg;
+    int i;
+
+    if (!size)
+        return 0;
+
+    if (decimals < 0)
+        decimals = 0;
+    if (decimals > ECHART_SCALE_DECIMALS_MAX)
+        decimals = ECHART_SCALE_DECIMALS_MAX;
+
+    v *= _echart_scale_pow10[decimals];
+    if (!(fabs(v) < 9e18))
+    {
+        snprintf(buf, size, "%g", v / _echart_scale_pow10[decimals]);
+        buf[size - 1] = '\0';
+        return strlen(buf);
+    }
+
+    neg = v < 0;
+    u = (unsigned long long)(fabs(v) + 0.5);
+    if (!u)
+        neg = 0;
+
+    /* digits in reverse order */
+    n = 0;
+    for (i = 0; i < decimals; i++)
+    {
+        tmp[n++] = '0' + (u % 10);
+        u /= 10;
+    }
+    if (decimals)
+        tmp[n++] = '.';
+    do
+    {
+        tmp[n++] = '0' + (u % 10);
+        u /= 10;
+    } while (u);
+    if (neg)
+        tmp[n++] = '-';
+
+    len = 0;
+    while (n && (len < size - 1))
+        buf[len++] = tmp[--n];
+    buf[len] = '\0';
+
+    return len;
+}
@@ -0,0 +1,58 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_SCALE_H
+#define ECHART_SCALE_H
+
+/*
+ * Ticks of an axis: nbr + 1 ticks from min to max, step apart. It is a
+ * cache, computed again only when the range, the number of ticks or
+ * the length of the axis change.
+ */
+typedef struct
+{
+    /* key */
+    double vmin;
+    double vmax;
+    int nbr_req;
+    int length;
+    Eina_Bool fixed : 1;
+    Eina_Bool valid : 1;
+    /* ticks */
+    double min;
+    double max;
+    double step;
+    unsigned int nbr;
+    int decimals; /* of the labels */
+} Echart_Scale;
+
+void echart_scale_set(Echart_Scale *s,
+                      double min, double max,
+                      int nbr, int length,
+                      Eina_Bool fixed);
+
+double echart_scale_tick_get(const Echart_Scale *s, unsigned int i);
+
+size_t echart_scale_label_get(const Echart_Scale *s, unsigned int i,
+                              char *buf, size_t size);
+
+int echart_scale_decimals_get(double step);
+
+size_t echart_scale_format(double v, int decimals, char *buf, size_t size);
+
+#endif /* ECHART_SCALE_H */
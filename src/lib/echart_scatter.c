@@ -0,0 +1,672 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_text.h"
+#include "echart_raster.h"
+#include "echart_scatter.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_SCATTER_SMART_OBJ_GET(smart, o, type) \
+{ \
+    char *_echart_scatter_smart_str; \
+    if (!o) return; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) return; \
+    _echart_scatter_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_scatter_smart_str) return; \
+    if (strcmp(_echart_scatter_smart_str, type)) return; \
+}
+
+#define ECHART_SCATTER_OBJ_NAME "echart_scatter_object"
+
+/*
+ * Above this number of marker pixels per plot pixel, the markers hide
+ * each other and the density tells more.
+ */
+#define ECHART_SCATTER_DENSITY_COVERAGE 4.0
+
+typedef struct
+{
+    Echart_Smart_Common common;
+    double radius;
+    Echart_Scatter_Density density;
+} Echart_Smart_Data;
+
+static Evas_Smart *_echart_scatter_smart = NULL;
+
+static void
+_echart_scatter_smart_add(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = calloc(1, sizeof(Echart_Smart_Data));
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_INIT((Echart_Smart_Common *)sd);
+
+    sd->common.bg = evas_object_rectangle_add(evas_object_evas_get(obj));
+    sd->common.title = evas_object_text_add(evas_object_evas_get(obj));
+    sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
+    sd->common.root = evas_vg_container_add(sd->common.vg);
+    evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+
+    sd->radius = 2;
+    sd->density = ECHART_SCATTER_DENSITY_AUTO;
+
+    evas_object_smart_data_set(obj, sd);
+}
+
+static void
+_echart_scatter_smart_del(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
+    {
+        evas_object_del(sd->common.bg);
+        evas_object_del(sd->common.title);
+        evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        free(sd);
+    }
+}
+
+static void
+_echart_scatter_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+    Echart_Smart_Data *sd;
+    Evas_Coord ox;
+    Evas_Coord oy;
+    Evas_Coord dx;
+    Evas_Coord dy;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_geometry_get(obj, &ox, &oy, NULL, NULL);
+    dx = x - ox;
+    dy = y - oy;
+
+    evas_object_geometry_get(sd->common.bg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.bg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.title, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.title, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.vg, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.vg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+}
+
+static void
+_echart_scatter_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
+}
+
+static void
+_echart_scatter_smart_show(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_show(sd->common.bg);
+    evas_object_show(sd->common.title);
+    echart_backend_set((Echart_Smart_Common *)sd, EINA_TRUE);
+}
+
+static void
+_echart_scatter_smart_hide(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_hide(sd->common.bg);
+    evas_object_hide(sd->common.title);
+    evas_object_hide(sd->common.vg);
+    evas_object_hide(sd->common.img);
+}
+
+static void
+_echart_scatter_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_set(sd->common.bg, clip);
+    evas_object_clip_set(sd->common.title, clip);
+    evas_object_clip_set(sd->common.vg, clip);
+    evas_object_clip_set(sd->common.img, clip);
+}
+
+static void
+_echart_scatter_smart_clip_unset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_unset(sd->common.bg);
+    evas_object_clip_unset(sd->common.title);
+    evas_object_clip_unset(sd->common.vg);
+    evas_object_clip_unset(sd->common.img);
+}
+
+/* color of the markers, the opacity of the serie being used */
+static unsigned int
+_echart_scatter_color_get(const Echart_Serie *serie)
+{
+    Echart_Colors cols;
+    unsigned int a;
+
+    cols = echart_serie_color_get(serie);
+    a = 255 * echart_serie_opacity_get(serie);
+    if (a < 128)
+        a = 128;
+
+    return (a << 24) | (cols.line & 0x00ffffff);
+}
+
+/*
+ * Density is used when the markers of all the series would cover the
+ * plot several times.
+ */
+static Eina_Bool
+_echart_scatter_density_get(const Echart_Smart_Data *sd,
+                            unsigned int nbr_points)
+{
+    double plot;
+    double markers;
+
+    if (sd->density != ECHART_SCATTER_DENSITY_AUTO)
+        return sd->density == ECHART_SCATTER_DENSITY_ON;
+
+    plot = (double)(sd->common.w_vg - 2 * sd->common.padding) *
+           (double)(sd->common.h_vg - 2 * sd->common.padding);
+    if (plot <= 0)
+        return EINA_FALSE;
+
+    markers = nbr_points * 3.14159265358979 * sd->radius * sd->radius;
+
+    return markers > ECHART_SCATTER_DENSITY_COVERAGE * plot;
+}
+
+static void
+_echart_scatter_raster_draw(Echart_Smart_Data *sd,
+                            double xmin, double xmax,
+                            double ymin, double ymax)
+{
+    Echart_Raster r;
+    Echart_Raster_Transform t;
+    const Echart_Data *data;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_List *series;
+    const Eina_List *l;
+    const Eina_Inarray *x_values;
+    unsigned int col;
+    unsigned int nbr_points;
+    double *xv;
+    int gyn;
+    Eina_Bool density;
+    Eina_Bool sorted;
+
+    if (!echart_raster_begin(&r, sd->common.img,
+                             sd->common.w_vg, sd->common.h_vg))
+        return;
+
+    echart_raster_clear(&r, 0x00000000);
+
+    /* axis */
+    echart_raster_rect_fill(&r,
+                            PAD(0), PAD(0),
+                            PAD(1), sd->common.h_vg - PAD(0),
+                            0xff000000);
+    echart_raster_rect_fill(&r,
+                            PAD(0), sd->common.h_vg - PAD(1),
+                            sd->common.w_vg - PAD(0), sd->common.h_vg - PAD(0),
+                            0xff000000);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        int i;
+
+        for (i = 1; i <= gyn; i++)
+        {
+            double y = i * (ymax - ymin) / gyn + ymin;
+            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            echart_raster_rect_fill(&r,
+                                    PAD(0.5), j + PAD(0),
+                                    sd->common.w_vg - PAD2(0.5), j + PAD(1),
+                                    col);
+        }
+    }
+
+    /* points */
+    data = echart_chart_data_get(sd->common.chart);
+    absciss = echart_data_absciss_get(data);
+    x_values = echart_serie_values_get(absciss);
+    xv = (double *)x_values->members;
+    series = echart_data_series_get(data);
+    sorted = echart_serie_sorted_get(absciss);
+
+    echart_raster_transform_set(&t,
+                                xmin, xmax,
+                                ymin, ymax,
+                                sd->common.padding, sd->common.padding,
+                                sd->common.w_vg - 2 * sd->common.padding,
+                                sd->common.h_vg - 2 * sd->common.padding);
+
+    nbr_points = x_values->len * eina_list_count(series);
+    density = _echart_scatter_density_get(sd, nbr_points);
+
+    EINA_LIST_FOREACH(series, l, serie)
+    {
+        const Eina_Inarray *y_values;
+
+        y_values = echart_serie_values_get(serie);
+        if (y_values->len < x_values->len)
+            continue;
+
+        col = _echart_scatter_color_get(serie);
+        if (density)
+            echart_raster_density(&r, &t, xv, (double *)y_values->members,
+                                  0, x_values->len - 1,
+                                  col | 0xff000000);
+        else
+            echart_raster_markers(&r, &t, xv, (double *)y_values->members,
+                                  0, x_values->len - 1, sorted,
+                                  sd->radius, col);
+    }
+
+    echart_raster_end(&r, sd->common.img);
+}
+
+/*
+ * All the markers of a serie are the sub paths of a single shape, only
+ * the points in the window being added.
+ */
+static void
+_echart_scatter_serie_add(const Echart_Smart_Data *sd,
+                          const double *xv, const double *yv,
+                          unsigned int first, unsigned int last,
+                          double xmin, double xmax,
+                          double ymin, double ymax,
+                          unsigned int col)
+{
+    Efl_VG *shape;
+    double ax;
+    double ay;
+    unsigned int i;
+    int a;
+    int r;
+    int g;
+    int b;
+
+    ax = (sd->common.w_vg - 2 * sd->common.padding) / (xmax - xmin);
+    ay = (sd->common.h_vg - 2 * sd->common.padding) / (ymax - ymin);
+
+    shape = evas_vg_shape_add(sd->common.root);
+    for (i = first; i <= last; i++)
+    {
+        if ((xv[i] < xmin) || (xv[i] > xmax) ||
+            (yv[i] < ymin) || (yv[i] > ymax))
+            continue;
+
+        evas_vg_shape_append_circle(shape,
+                                    sd->common.padding + ax * (xv[i] - xmin),
+                                    sd->common.padding + ay * (ymax - yv[i]),
+                                    sd->radius);
+    }
+
+    a = COL_TO_A(col);
+    r = ((COL_TO_R(col) * a) >> 8);
+    g = ((COL_TO_G(col) * a) >> 8);
+    b = ((COL_TO_B(col) * a) >> 8);
+    evas_vg_node_color_set(shape, r, g, b, a);
+}
+
+static void
+_echart_scatter_smart_calculate(Evas_Object *obj)
+{
+    Echart_Font_Style fs;
+    const Echart_Data *data;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_List *series;
+    const Eina_List *l;
+    const Eina_Inarray *x_values;
+    Echart_Smart_Data *sd;
+    unsigned int col;
+    unsigned int first;
+    unsigned int last;
+    Efl_VG *shape;
+    double *xv;
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    int gyn;
+    int w;
+    int h;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    sd->common.padding = 5;
+
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
+    col = echart_chart_background_color_get(sd->common.chart);
+
+    /* background */
+    echart_background_set((Echart_Smart_Common *)sd, w, h, col);
+
+    /* title */
+    if (echart_chart_title_get(sd->common.chart))
+    {
+        Evas_Coord w_title;
+
+        echart_chart_title_style_get(sd->common.chart, &fs);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
+        evas_object_move(sd->common.title, (w - w_title) / 2, 0);
+    }
+
+    /* vg */
+    echart_vg_set((Echart_Smart_Common *)sd);
+    echart_backend_set((Echart_Smart_Common *)sd, evas_object_visible_get(obj));
+    echart_vg_reset((Echart_Smart_Common *)sd);
+
+    if (!echart_viewport_get((Echart_Smart_Common *)sd,
+                             &xmin, &xmax, &ymin, &ymax))
+        return;
+
+    if (sd->common.backend == ECHART_BACKEND_RASTER)
+    {
+        _echart_scatter_raster_draw(sd, xmin, xmax, ymin, ymax);
+        return;
+    }
+
+    /* axis */
+    shape = evas_vg_shape_add(sd->common.root);
+    evas_vg_shape_append_move_to(shape, PAD(0.5), PAD(0.5));
+    evas_vg_shape_append_line_to(shape, PAD(0.5), sd->common.h_vg - PAD(0.5));
+    evas_vg_shape_append_line_to(shape, sd->common.w_vg - PAD(0.5), sd->common.h_vg - PAD(0.5));
+    evas_vg_shape_stroke_width_set(shape, 1);
+    evas_vg_shape_stroke_color_set(shape, 0, 0, 0, 255);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        int i;
+
+        for (i = 1; i <= gyn; i++)
+        {
+            double y = i * (ymax - ymin) / gyn + ymin;
+            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            shape = evas_vg_shape_add(sd->common.root);
+            evas_vg_shape_append_move_to(shape, PAD(0.5), j + PAD(0.5));
+            evas_vg_shape_append_line_to(shape, sd->common.w_vg - PAD2(0.5), j + PAD(0.5));
+            evas_vg_shape_stroke_width_set(shape, 1);
+            evas_vg_shape_stroke_color_set(shape,
+                                           COL_TO_R(col), COL_TO_G(col), COL_TO_B(col), COL_TO_A(col));
+        }
+    }
+
+    /* points, one shape per serie */
+    data = echart_chart_data_get(sd->common.chart);
+    absciss = echart_data_absciss_get(data);
+    x_values = echart_serie_values_get(absciss);
+    xv = (double *)x_values->members;
+    series = echart_data_series_get(data);
+
+    /* only a sorted absciss reduces the range, the others are filtered */
+    echart_viewport_range_get(xv, x_values->len,
+                              echart_serie_sorted_get(absciss),
+                              xmin, xmax, &first, &last);
+
+    EINA_LIST_FOREACH(series, l, serie)
+    {
+        const Eina_Inarray *y_values;
+
+        y_values = echart_serie_values_get(serie);
+        if (y_values->len < x_values->len)
+            continue;
+
+        _echart_scatter_serie_add(sd, xv, (double *)y_values->members,
+                                  first, last,
+                                  xmin, xmax, ymin, ymax,
+                                  _echart_scatter_color_get(serie));
+    }
+}
+
+static void
+_echart_scatter_smart_init(void)
+{
+    static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION(ECHART_SCATTER_OBJ_NAME);
+
+    if (_echart_scatter_smart) return;
+
+    if (!sc.add)
+    {
+        sc.add = _echart_scatter_smart_add;
+        sc.del = _echart_scatter_smart_del;
+        sc.move = _echart_scatter_smart_move;
+        sc.resize = _echart_scatter_smart_resize;
+        sc.show = _echart_scatter_smart_show;
+        sc.hide = _echart_scatter_smart_hide;
+        sc.clip_set = _echart_scatter_smart_clip_set;
+        sc.clip_unset = _echart_scatter_smart_clip_unset;
+        sc.calculate = _echart_scatter_smart_calculate;
+    }
+    _echart_scatter_smart = evas_smart_class_new(&sc);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Evas_Object *
+echart_scatter_object_add(Evas *evas)
+{
+    Evas_Object *obj;
+
+    _echart_scatter_smart_init();
+    obj = evas_object_smart_add(evas, _echart_scatter_smart);
+
+    return obj;
+}
+
+EAPI void
+echart_scatter_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+    INF("chart set");
+
+    sd->common.chart = chart;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_marker_size_set(Evas_Object *obj, double radius)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    if (radius <= 0)
+        return;
+
+    sd->radius = radius;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_density_set(Evas_Object *obj, Echart_Scatter_Density density)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    sd->density = density;
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_viewport_set(Evas_Object *obj,
+                                   double xmin, double xmax,
+                                   double ymin, double ymax)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    echart_viewport_set((Echart_Smart_Common *)sd, xmin, xmax, ymin, ymax);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_viewport_get(const Evas_Object *obj,
+                                   double *xmin, double *xmax,
+                                   double *ymin, double *ymax)
+{
+    Echart_Smart_Data *sd;
+    double x0 = 0;
+    double x1 = 0;
+    double y0 = 0;
+    double y1 = 0;
+
+    if (xmin) *xmin = 0;
+    if (xmax) *xmax = 0;
+    if (ymin) *ymin = 0;
+    if (ymax) *ymax = 0;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    echart_viewport_get((Echart_Smart_Common *)sd, &x0, &x1, &y0, &y1);
+    if (xmin) *xmin = x0;
+    if (xmax) *xmax = x1;
+    if (ymin) *ymin = y0;
+    if (ymax) *ymax = y1;
+}
+
+EAPI void
+echart_scatter_object_viewport_reset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    echart_viewport_reset((Echart_Smart_Common *)sd);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_pan(Evas_Object *obj, double dx, double dy)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    echart_viewport_pan((Echart_Smart_Common *)sd, dx, dy);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
+
+EAPI void
+echart_scatter_object_zoom(Evas_Object *obj, double factor, double x, double y)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SCATTER_SMART_OBJ_GET(sd, obj, ECHART_SCATTER_OBJ_NAME);
+
+    echart_viewport_zoom((Echart_Smart_Common *)sd, factor, x, y);
+    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+}
@@ -0,0 +1,45 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_SCATTER_H
+#define ECHART_SCATTER_H
+
+/* how the points of a serie are drawn */
+typedef enum
+{
+    ECHART_SCATTER_DENSITY_AUTO, /* density when the markers cover the plot */
+    ECHART_SCATTER_DENSITY_OFF,  /* always markers */
+    ECHART_SCATTER_DENSITY_ON    /* always density (raster backend only) */
+} Echart_Scatter_Density;
+
+EAPI Evas_Object *echart_scatter_object_add(Evas *evas);
+EAPI void echart_scatter_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
+EAPI void echart_scatter_object_marker_size_set(Evas_Object *obj, double radius);
+EAPI void echart_scatter_object_density_set(Evas_Object *obj, Echart_Scatter_Density density);
+
+EAPI void echart_scatter_object_viewport_set(Evas_Object *obj,
+                                             double xmin, double xmax,
+                                             double ymin, double ymax);
+EAPI void echart_scatter_object_viewport_get(const Evas_Object *obj,
+                                             double *xmin, double *xmax,
+                                             double *ymin, double *ymax);
+EAPI void echart_scatter_object_viewport_reset(Evas_Object *obj);
+EAPI void echart_scatter_object_pan(Evas_Object *obj, double dx, double dy);
+EAPI void echart_scatter_object_zoom(Evas_Object *obj, double factor, double x, double y);
+
+#endif /* ECHART_SCATTER_H */
@@ -0,0 +1,458 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_raster.h"
+#include "echart_line.h"
+#include "echart_lod.h"
+#include "echart_sparkline.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_SPARKLINE_SMART_OBJ_GET(smart, o, type) \
+{ \
+    char *_echart_sparkline_smart_str; \
+    if (!o) return; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) return; \
+    _echart_sparkline_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_sparkline_smart_str) return; \
+    if (strcmp(_echart_sparkline_smart_str, type)) return; \
+}
+
+#define ECHART_SPARKLINE_SMART_OBJ_GET_ERROR(smart, o, type) \
+{ \
+    char *_echart_sparkline_smart_str; \
+    if (!o) goto _err; \
+    smart = evas_object_smart_data_get(o); \
+    if (!smart) goto _err; \
+    _echart_sparkline_smart_str = (char *)evas_object_type_get(o); \
+    if (!_echart_sparkline_smart_str) goto _err; \
+    if (strcmp(_echart_sparkline_smart_str, type)) goto _err; \
+}
+
+#define ECHART_SPARKLINE_OBJ_NAME "echart_sparkline_object"
+
+/*
+ * Only the VG object of the common part is created, with one shape
+ * whose path is rebuilt in place. The decimated samples depend only on
+ * the data and on the width, so they are kept when the height changes
+ * or when the object is moved.
+ */
+typedef struct
+{
+    Echart_Smart_Common common;
+    Echart_Data *data;
+    Efl_VG *line; /* the only shape */
+    double *lod_x;
+    double *lod_y;
+    unsigned int lod_size;
+    unsigned int lod_columns; /* key of the decimated samples */
+    unsigned int lod_len;
+    unsigned int nbr; /* decimated samples, 0 to draw the raw ones */
+    Eina_Bool lod_valid;
+} Echart_Smart_Data;
+
+static Evas_Smart *_echart_sparkline_smart = NULL;
+
+static void
+_echart_sparkline_smart_add(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = calloc(1, sizeof(Echart_Smart_Data));
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_INIT((Echart_Smart_Common *)sd);
+
+    sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
+    evas_object_pass_events_set(sd->common.vg, EINA_TRUE);
+    sd->common.root = evas_vg_container_add(sd->common.vg);
+    evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->line = evas_vg_shape_add(sd->common.root);
+    evas_vg_shape_stroke_width_set(sd->line, 1);
+
+    sd->common.need_layout = EINA_TRUE;
+
+    evas_object_smart_data_set(obj, sd);
+}
+
+static void
+_echart_sparkline_smart_del(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
+    {
+        if (sd->data)
+            echart_data_free(sd->data);
+        free(sd->lod_x);
+        free(sd->lod_y);
+        evas_object_del(sd->common.vg);
+        free(sd);
+    }
+}
+
+static void
+_echart_sparkline_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    /* the shape is relative to the VG object, nothing to compute */
+    evas_object_move(sd->common.vg, x, y);
+}
+
+static void
+_echart_sparkline_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
+}
+
+static void
+_echart_sparkline_smart_show(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_show(sd->common.vg);
+}
+
+static void
+_echart_sparkline_smart_hide(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_hide(sd->common.vg);
+}
+
+static void
+_echart_sparkline_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_set(sd->common.vg, clip);
+}
+
+static void
+_echart_sparkline_smart_clip_unset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    evas_object_clip_unset(sd->common.vg);
+}
+
+/*
+ * Decimate the samples [0, len - 1] for columns pixels, when there are
+ * more samples than pixels. The decimation needs a sorted absciss.
+ */
+static void
+_echart_sparkline_lod_set(Echart_Smart_Data *sd,
+                          const double *xv, const double *yv,
+                          unsigned int len, Eina_Bool sorted,
+                          double xmin, double xmax,
+                          unsigned int columns)
+{
+    Echart_Lod lod;
+    unsigned int size;
+
+    sd->lod_valid = EINA_TRUE;
+    sd->lod_columns = columns;
+    sd->lod_len = len;
+    sd->nbr = 0;
+
+    if (!sorted)
+        return;
+
+    lod = echart_lod_select(ECHART_LOD_RAW, len, columns);
+    if (lod == ECHART_LOD_RAW)
+        return;
+
+    size = 4 * (columns + 2);
+    if (size > sd->lod_size)
+    {
+        double *lod_x;
+        double *lod_y;
+
+        lod_x = (double *)realloc(sd->lod_x, size * sizeof(double));
+        if (!lod_x)
+            return;
+        sd->lod_x = lod_x;
+        lod_y = (double *)realloc(sd->lod_y, size * sizeof(double));
+        if (!lod_y)
+            return;
+        sd->lod_y = lod_y;
+        sd->lod_size = size;
+    }
+
+    if (lod == ECHART_LOD_DOWNSAMPLE)
+        sd->nbr = echart_lod_downsample(xv, yv, 0, len - 1, columns,
+                                        sd->lod_x, sd->lod_y);
+    else
+        sd->nbr = echart_lod_envelope(xv, yv, 0, len - 1, xmin, xmax, columns,
+                                      sd->lod_x, sd->lod_y);
+}
+
+static void
+_echart_sparkline_layout_update(Echart_Smart_Data *sd)
+{
+    Echart_Raster_Transform t;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_Inarray *x_values;
+    const Eina_Inarray *y_values;
+    const double *xv;
+    const double *yv;
+    Echart_Colors cols;
+    unsigned int columns;
+    unsigned int first;
+    unsigned int last;
+    unsigned int i;
+    double xmin;
+    double xmax;
+    double ymin;
+    double ymax;
+    Eina_Bool sorted;
+
+    evas_object_resize(sd->common.vg, sd->common.w, sd->common.h);
+    evas_vg_shape_reset(sd->line);
+
+    /* one pixel around for the width of the line */
+    if (!sd->data || (sd->common.w < 3) || (sd->common.h < 3))
+        return;
+
+    absciss = echart_data_absciss_get(sd->data);
+    serie = eina_list_data_get(echart_data_series_get(sd->data));
+    x_values = echart_serie_values_get(absciss);
+    y_values = echart_serie_values_get(serie);
+    if (!x_values || !y_values || !x_values->len ||
+        (y_values->len < x_values->len))
+        return;
+
+    xv = (const double *)x_values->members;
+    yv = (const double *)y_values->members;
+    sorted = echart_serie_sorted_get(absciss);
+    echart_serie_interval_get(absciss, &xmin, &xmax);
+    if (xmax <= xmin)
+        xmax = xmin + 1;
+    echart_serie_interval_get(serie, &ymin, &ymax);
+    if (ymax <= ymin)
+    {
+        ymin -= 0.5;
+        ymax = ymin + 1;
+    }
+
+    columns = sd->common.w - 2;
+    if (!sd->lod_valid ||
+        (sd->lod_columns != columns) || (sd->lod_len != x_values->len))
+        _echart_sparkline_lod_set(sd, xv, yv, x_values->len, sorted,
+                                  xmin, xmax, columns);
+
+    first = 0;
+    last = x_values->len - 1;
+    if (sd->nbr)
+    {
+        xv = sd->lod_x;
+        yv = sd->lod_y;
+        last = sd->nbr - 1;
+    }
+
+    echart_raster_transform_set(&t,
+                                xmin, xmax,
+                                ymin, ymax,
+                                1, 1,
+                                sd->common.w - 3, sd->common.h - 3);
+
+    evas_vg_shape_append_move_to(sd->line,
+                                 t.ax * xv[first] + t.bx,
+                                 t.ay * yv[first] + t.by);
+    for (i = first + 1; i <= last; i++)
+        evas_vg_shape_append_line_to(sd->line,
+                                     t.ax * xv[i] + t.bx,
+                                     t.ay * yv[i] + t.by);
+
+    cols = echart_serie_color_get(serie);
+    evas_vg_shape_stroke_color_set(sd->line,
+                                   COL_TO_R(cols.line),
+                                   COL_TO_G(cols.line),
+                                   COL_TO_B(cols.line),
+                                   COL_TO_A(cols.line));
+}
+
+static void
+_echart_sparkline_smart_calculate(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    /* called once per frame, see echart_object_changed() */
+    if (sd->common.need_layout || sd->common.need_resize)
+    {
+        /* a resize alone keeps the decimated samples of the same width */
+        if (sd->common.need_layout)
+            sd->lod_valid = EINA_FALSE;
+        sd->common.need_layout = EINA_FALSE;
+        sd->common.need_resize = EINA_FALSE;
+        _echart_sparkline_layout_update(sd);
+    }
+}
+
+static void
+_echart_sparkline_smart_init(void)
+{
+    static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION(ECHART_SPARKLINE_OBJ_NAME);
+
+    if (_echart_sparkline_smart) return;
+
+    if (!sc.add)
+    {
+        sc.add = _echart_sparkline_smart_add;
+        sc.del = _echart_sparkline_smart_del;
+        sc.move = _echart_sparkline_smart_move;
+        sc.resize = _echart_sparkline_smart_resize;
+        sc.show = _echart_sparkline_smart_show;
+        sc.hide = _echart_sparkline_smart_hide;
+        sc.clip_set = _echart_sparkline_smart_clip_set;
+        sc.clip_unset = _echart_sparkline_smart_clip_unset;
+        sc.calculate = _echart_sparkline_smart_calculate;
+    }
+    _echart_sparkline_smart = evas_smart_class_new(&sc);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Evas_Object *
+echart_sparkline_object_add(Evas *evas)
+{
+    Evas_Object *obj;
+
+    _echart_sparkline_smart_init();
+    obj = evas_object_smart_add(evas, _echart_sparkline_smart);
+
+    return obj;
+}
+
+EAPI void
+echart_sparkline_object_data_set(Evas_Object *obj, Echart_Data *data)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SPARKLINE_SMART_OBJ_GET(sd, obj, ECHART_SPARKLINE_OBJ_NAME);
+
+    /* like echart_chart_data_set(), even if it is the same data */
+    if (sd->data)
+        echart_data_free(sd->data);
+    sd->data = data;
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI const Echart_Data *
+echart_sparkline_object_data_get(const Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SPARKLINE_SMART_OBJ_GET_ERROR(sd, obj, ECHART_SPARKLINE_OBJ_NAME);
+
+    return sd->data;
+
+  _err:
+    return NULL;
+}
+
+EAPI void
+echart_sparkline_object_update(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_SPARKLINE_SMART_OBJ_GET(sd, obj, ECHART_SPARKLINE_OBJ_NAME);
+
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
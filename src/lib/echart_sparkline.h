@@ -0,0 +1,36 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_SPARKLINE_H
+#define ECHART_SPARKLINE_H
+
+/*
+ * Tiny line chart, without background, title, axis nor labels: the
+ * first serie of the data is drawn as a single shape filling the
+ * object, its samples being decimated to the width of the object.
+ */
+EAPI Evas_Object *echart_sparkline_object_add(Evas *evas);
+
+/* the sparkline takes over the reference of the caller on data */
+EAPI void echart_sparkline_object_data_set(Evas_Object *obj, Echart_Data *data);
+EAPI const Echart_Data *echart_sparkline_object_data_get(const Evas_Object *obj);
+
+/* to call when samples have been pushed in the series of the data */
+EAPI void echart_sparkline_object_update(Evas_Object *obj);
+
+#endif /* ECHART_SPARKLINE_H */
@@ -0,0 +1,221 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * A mark costs one read of the monotonic clock, and the durations are
+ * only summed during the frame, so the statistics stay enabled.
+ */
+
+static Echart_Smart_Common *
+_echart_stats_common_get(const Evas_Object *obj)
+{
+    const char *type;
+
+    if (!obj)
+        return NULL;
+
+    /* the smart data of all the objects start with the common part */
+    type = evas_object_type_get(obj);
+    if (!type || strncmp(type, "echart_", 7))
+        return NULL;
+
+    return evas_object_smart_data_get(obj);
+}
+
+static void
+_echart_stats_histogram_add(Echart_Stats_Timing *timing, double duration)
+{
+    unsigned int us;
+    unsigned int sum;
+    unsigned int i;
+
+    us = (unsigned int)(duration * 1000000.0);
+    i = 0;
+    while ((us >>= 1) && (i < ECHART_STATS_HISTOGRAM_SIZE - 1))
+        i++;
+    timing->histogram[i]++;
+
+    sum = 0;
+    for (i = 0; i < ECHART_STATS_HISTOGRAM_SIZE; i++)
+        sum += timing->histogram[i];
+    if (sum >= ECHART_STATS_HISTOGRAM_WINDOW)
+    {
+        for (i = 0; i < ECHART_STATS_HISTOGRAM_SIZE; i++)
+            timing->histogram[i] >>= 1;
+    }
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+/* monotonic time, in seconds */
+double
+echart_stats_time_get(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+#endif
+}
+
+/*
+ * Start a frame. The counts of the last layout are only reset when the
+ * frame lays the object out, not for a move of the pointer.
+ */
+void
+echart_stats_frame_begin(Echart_Stats_Recorder *sr, Eina_Bool layout)
+{
+    unsigned int i;
+
+    for (i = 0; i < ECHART_STATS_STAGE_LAST; i++)
+        sr->frame[i] = 0;
+    sr->stages = 0;
+
+    if (layout)
+    {
+        sr->stats.points_in = 0;
+        sr->stats.points_out = 0;
+        sr->stats.vg_nodes = 0;
+        sr->stats.text_objects = 0;
+    }
+
+    sr->mark = echart_stats_time_get();
+}
+
+/* the time since the last mark is spent in stage */
+void
+echart_stats_mark(Echart_Stats_Recorder *sr, Echart_Stats_Stage stage)
+{
+    double t;
+
+    t = echart_stats_time_get();
+    sr->frame[stage] += t - sr->mark;
+    sr->stages |= 1 << stage;
+    sr->mark = t;
+}
+
+void
+echart_stats_frame_end(Echart_Stats_Recorder *sr)
+{
+    unsigned int i;
+
+    sr->stats.frames++;
+    for (i = 0; i < ECHART_STATS_STAGE_LAST; i++)
+    {
+        Echart_Stats_Timing *timing;
+
+        if (!(sr->stages & (1 << i)))
+            continue;
+
+        timing = sr->stats.stages + i;
+        timing->count++;
+        timing->last = sr->frame[i];
+        timing->total += sr->frame[i];
+        if (sr->frame[i] > timing->max)
+            timing->max = sr->frame[i];
+        if (sr->histograms)
+            _echart_stats_histogram_add(timing, sr->frame[i]);
+    }
+}
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Eina_Bool
+echart_stats_get(const Evas_Object *obj, Echart_Stats *stats)
+{
+    Echart_Smart_Common *esc;
+
+    EINA_SAFETY_ON_NULL_RETURN_VAL(stats, EINA_FALSE);
+
+    esc = _echart_stats_common_get(obj);
+    if (!esc)
+        return EINA_FALSE;
+
+    *stats = esc->stats.stats;
+
+    return EINA_TRUE;
+}
+
+EAPI void
+echart_stats_reset(Evas_Object *obj)
+{
+    Echart_Smart_Common *esc;
+
+    esc = _echart_stats_common_get(obj);
+    if (!esc)
+        return;
+
+    memset(&esc->stats.stats, 0, sizeof(Echart_Stats));
+}
+
+EAPI void
+echart_stats_histograms_set(Evas_Object *obj, Eina_Bool on)
+{
+    Echart_Smart_Common *esc;
+
+    esc = _echart_stats_common_get(obj);
+    if (!esc)
+        return;
+
+    esc->stats.histograms = !!on;
+}
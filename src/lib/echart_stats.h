@@ -0,0 +1,87 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_STATS_H
+#define ECHART_STATS_H
+
+/* stages of the calculation of an object */
+typedef enum
+{
+    ECHART_STATS_STAGE_BOUNDS,    /* background, title, intervals and scales of the data */
+    ECHART_STATS_STAGE_LABELS,    /* ticks and text objects of the labels */
+    ECHART_STATS_STAGE_TRANSFORM, /* visible samples, decimation, interactive transform */
+    ECHART_STATS_STAGE_PATH,      /* pixel coordinates and shapes or raster commands */
+    ECHART_STATS_STAGE_SUBMIT,    /* geometry of the VG object, drawing of the image */
+    ECHART_STATS_STAGE_HOVER,     /* hit-testing and feedback of the pointer */
+    ECHART_STATS_STAGE_LAST
+} Echart_Stats_Stage;
+
+/* bucket i counts the durations in [2^i, 2^(i+1)[ microseconds */
+#define ECHART_STATS_HISTOGRAM_SIZE 16
+#define ECHART_STATS_HISTOGRAM_WINDOW 1024
+
+typedef struct
+{
+    unsigned int count; /* frames running the stage */
+    double last; /* in seconds */
+    double total;
+    double max;
+    unsigned int histogram[ECHART_STATS_HISTOGRAM_SIZE]; /* see echart_stats_histograms_set() */
+} Echart_Stats_Timing;
+
+typedef struct
+{
+    unsigned int frames;
+    Echart_Stats_Timing stages[ECHART_STATS_STAGE_LAST];
+    /* last layout */
+    unsigned int points_in; /* samples in the window */
+    unsigned int points_out; /* vertices drawn, after decimation */
+    unsigned int vg_nodes; /* shapes created */
+    unsigned int text_objects;
+} Echart_Stats;
+
+/*
+ * Statistics of the calculations of an object of the library. Only the
+ * line and vbar objects record them, they stay at 0 for the others.
+ * The histograms are off by default. They are rolling: when a stage
+ * has ECHART_STATS_HISTOGRAM_WINDOW durations, its buckets are halved,
+ * so that the old frames fade out.
+ */
+EAPI Eina_Bool echart_stats_get(const Evas_Object *obj, Echart_Stats *stats);
+EAPI void echart_stats_reset(Evas_Object *obj);
+EAPI void echart_stats_histograms_set(Evas_Object *obj, Eina_Bool on);
+
+/* statistics of an object, in its common part */
+typedef struct
+{
+    Echart_Stats stats;
+    double frame[ECHART_STATS_STAGE_LAST]; /* durations of the current frame */
+    unsigned int stages; /* bit mask of the stages of the current frame */
+    double mark; /* end of the last stage */
+    Eina_Bool histograms;
+} Echart_Stats_Recorder;
+
+double echart_stats_time_get(void);
+
+void echart_stats_frame_begin(Echart_Stats_Recorder *sr, Eina_Bool layout);
+
+void echart_stats_mark(Echart_Stats_Recorder *sr, Echart_Stats_Stage stage);
+
+void echart_stats_frame_end(Echart_Stats_Recorder *sr);
+
+#endif /* ECHART_STATS_H */
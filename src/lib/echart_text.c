@@ -0,0 +1,298 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_data.h"
+#include "echart_chart.h"
+#include "echart_common.h"
+#include "echart_text.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/*
+ * The font descriptions of the last styles and the size of the labels
+ * already drawn are shared by all the chart objects. Like the Evas
+ * objects, they are only used from the main loop.
+ */
+
+#define ECHART_TEXT_FONTS 8
+#define ECHART_TEXT_SIZES_MAX 4096
+
+typedef struct
+{
+    char *name;
+    Eina_Bool bold : 1;
+    Eina_Bool italic : 1;
+    char desc[256]; /* "name:style=..." */
+    size_t len;
+} Echart_Text_Font;
+
+typedef struct
+{
+    Evas_Coord w;
+    Evas_Coord h;
+} Echart_Text_Size;
+
+static Echart_Text_Font _echart_text_fonts[ECHART_TEXT_FONTS];
+static unsigned int _echart_text_fonts_next = 0;
+static Eina_Hash *_echart_text_sizes = NULL;
+
+static const Echart_Text_Font *
+_echart_text_font_get(const Echart_Font_Style *fs)
+{
+    Echart_Text_Font *f;
+    const char *name;
+    const char *style;
+    unsigned int i;
+
+    name = fs->font_name ? fs->font_name : "Sans";
+    for (i = 0; i < ECHART_TEXT_FONTS; i++)
+    {
+        f = _echart_text_fonts + i;
+        if (f->name &&
+            (f->bold == fs->bold) && (f->italic == fs->italic) &&
+            !strcmp(f->name, name))
+            return f;
+    }
+
+    /* the oldest description is replaced */
+    f = _echart_text_fonts + _echart_text_fonts_next;
+    _echart_text_fonts_next = (_echart_text_fonts_next + 1) % ECHART_TEXT_FONTS;
+
+    free(f->name);
+    f->name = strdup(name);
+    if (!f->name)
+        return NULL;
+    f->bold = fs->bold;
+    f->italic = fs->italic;
+
+    style = "";
+    if (fs->bold && fs->italic)
+        style = ":style=Bold Italic";
+    else if (fs->bold)
+        style = ":style=Bold";
+    else if (fs->italic)
+        style = ":style=Italic";
+    snprintf(f->desc, sizeof(f->desc), "%s%s", name, style);
+    f->desc[sizeof(f->desc) - 1] = '\0';
+    f->len = strlen(f->desc);
+
+    return f;
+}
+
+/* "desc|size|text", NULL if too long to be cached */
+static const char *
+_echart_text_key_get(const Echart_Text_Font *f, int size, const char *text,
+                     char *key, size_t key_size)
+{
+    char digits[16];
+    size_t len;
+    size_t n;
+
+    n = 0;
+    do
+    {
+        digits[n++] = '0' + (size % 10);
+        size /= 10;
+    } while (size && (n < sizeof(digits)));
+
+    len = strlen(text);
+    if (f->len + n + len + 3 > key_size)
+        return NULL;
+
+    memcpy(key, f->desc, f->len);
+    len = f->len;
+    key[len++] = '|';
+    while (n)
+        key[len++] = digits[--n];
+    key[len++] = '|';
+    strcpy(key + len, text);
+
+    return key;
+}
+
+static int
+_echart_text_font_size_get(const Echart_Font_Style *fs)
+{
+    return (fs->font_size <= 0) ? 13 : fs->font_size;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+Eina_Bool
+echart_text_init(void)
+{
+    _echart_text_sizes = eina_hash_string_superfast_new(free);
+
+    return _echart_text_sizes != NULL;
+}
+
+void
+echart_text_shutdown(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < ECHART_TEXT_FONTS; i++)
+    {
+        free(_echart_text_fonts[i].name);
+        _echart_text_fonts[i].name = NULL;
+    }
+    _echart_text_fonts_next = 0;
+
+    eina_hash_free(_echart_text_sizes);
+    _echart_text_sizes = NULL;
+}
+
+/*
+ * Set the text and the style of the text object obj, only what changed
+ * being set again, and return its size, from the cache if the label has
+ * already been measured.
+ */
+void
+echart_text_object_set(Evas_Object *obj,
+                       const char *text,
+                       const Echart_Font_Style *fs,
+                       Evas_Coord *w, Evas_Coord *h)
+{
+    const Echart_Text_Font *f;
+    const char *cur_font;
+    const char *cur_text;
+    Evas_Font_Size cur_size;
+    int size;
+    int r;
+    int g;
+    int b;
+    int a;
+
+    if (!text)
+        return;
+
+    f = _echart_text_font_get(fs);
+    if (!f)
+        return;
+    size = _echart_text_font_size_get(fs);
+
+    if (evas_object_text_style_get(obj) != EVAS_TEXT_STYLE_PLAIN)
+        evas_object_text_style_set(obj, EVAS_TEXT_STYLE_PLAIN);
+
+    evas_object_color_get(obj, &r, &g, &b, &a);
+    if (((unsigned int)r != COL_TO_R(fs->font_color)) ||
+        ((unsigned int)g != COL_TO_G(fs->font_color)) ||
+        ((unsigned int)b != COL_TO_B(fs->font_color)) ||
+        ((unsigned int)a != COL_TO_A(fs->font_color)))
+        evas_object_color_set(obj,
+                              COL_TO_R(fs->font_color),
+                              COL_TO_G(fs->font_color),
+                              COL_TO_B(fs->font_color),
+                              COL_TO_A(fs->font_color));
+
+    cur_font = NULL;
+    cur_size = 0;
+    evas_object_text_font_get(obj, &cur_font, &cur_size);
+    if (!cur_font || (cur_size != size) || strcmp(cur_font, f->desc))
+        evas_object_text_font_set(obj, f->desc, size);
+
+    cur_text = evas_object_text_text_get(obj);
+    if (!cur_text || strcmp(cur_text, text))
+        evas_object_text_text_set(obj, text);
+
+    if (!w && !h)
+        return;
+
+    if (!echart_text_size_get(text, fs, w, h))
+    {
+        Echart_Text_Size *ts;
+        char key[512];
+
+        ts = (Echart_Text_Size *)malloc(sizeof(Echart_Text_Size));
+        if (!ts)
+        {
+            evas_object_geometry_get(obj, NULL, NULL, w, h);
+            return;
+        }
+
+        evas_object_geometry_get(obj, NULL, NULL, &ts->w, &ts->h);
+        if (w) *w = ts->w;
+        if (h) *h = ts->h;
+
+        if (!_echart_text_sizes ||
+            !_echart_text_key_get(f, size, text, key, sizeof(key)))
+        {
+            free(ts);
+            return;
+        }
+
+        /* the labels of a few charts, the cache is only a bound */
+        if (eina_hash_population(_echart_text_sizes) >= ECHART_TEXT_SIZES_MAX)
+            eina_hash_free_buckets(_echart_text_sizes);
+        if (!eina_hash_add(_echart_text_sizes, key, ts))
+            free(ts);
+    }
+}
+
+/*
+ * Size of a label already drawn with the style fs, without Evas. It
+ * returns EINA_FALSE if the label has not been measured yet.
+ */
+Eina_Bool
+echart_text_size_get(const char *text,
+                     const Echart_Font_Style *fs,
+                     Evas_Coord *w, Evas_Coord *h)
+{
+    const Echart_Text_Font *f;
+    const Echart_Text_Size *ts;
+    char key[512];
+
+    if (!_echart_text_sizes || !text)
+        return EINA_FALSE;
+
+    f = _echart_text_font_get(fs);
+    if (!f ||
+        !_echart_text_key_get(f, _echart_text_font_size_get(fs), text,
+                              key, sizeof(key)))
+        return EINA_FALSE;
+
+    ts = eina_hash_find(_echart_text_sizes, key);
+    if (!ts)
+        return EINA_FALSE;
+
+    if (w) *w = ts->w;
+    if (h) *h = ts->h;
+
+    return EINA_TRUE;
+}
@@ -0,0 +1,35 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_TEXT_H
+#define ECHART_TEXT_H
+
+Eina_Bool echart_text_init(void);
+
+void echart_text_shutdown(void);
+
+void echart_text_object_set(Evas_Object *obj,
+                            const char *text,
+                            const Echart_Font_Style *fs,
+                            Evas_Coord *w, Evas_Coord *h);
+
+Eina_Bool echart_text_size_get(const char *text,
+                               const Echart_Font_Style *fs,
+                               Evas_Coord *w, Evas_Coord *h);
+
+#endif /* ECHART_TEXT_H */
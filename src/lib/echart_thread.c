@@ -0,0 +1,230 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <Eina.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_thread.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#define ECHART_THREAD_MAX 32
+
+/*
+ * Pool of workers executing the jobs [0, count[ of the current batch.
+ * The thread calling echart_thread_run() takes jobs too, then waits for
+ * the end of the batch. Jobs are expected to be coarse (a tile, a slice
+ * of a serie), so taking the lock to fetch one is cheap.
+ */
+typedef struct
+{
+    Eina_Lock lock;
+    Eina_Condition cond_work;
+    Eina_Condition cond_done;
+    Eina_Thread threads[ECHART_THREAD_MAX];
+    unsigned int nbr_threads;
+    Echart_Thread_Job_Cb job;
+    void *data;
+    unsigned int count;
+    unsigned int next;
+    unsigned int done;
+    Eina_Bool busy : 1;
+    Eina_Bool quit : 1;
+} Echart_Thread_Pool;
+
+static Echart_Thread_Pool _echart_thread_pool;
+
+/* called with the lock taken */
+static void
+_echart_thread_jobs_process(Echart_Thread_Pool *pool)
+{
+    while (pool->next < pool->count)
+    {
+        unsigned int idx;
+
+        idx = pool->next++;
+        eina_lock_release(&pool->lock);
+        ECHART_TRACE_BEGIN("echart_thread_job");
+        pool->job(pool->data, idx);
+        ECHART_TRACE_END("echart_thread_job");
+        eina_lock_take(&pool->lock);
+        pool->done++;
+        if (pool->done == pool->count)
+            eina_condition_broadcast(&pool->cond_done);
+    }
+}
+
+static void *
+_echart_thread_worker(void *data, Eina_Thread t EINA_UNUSED)
+{
+    Echart_Thread_Pool *pool;
+
+    pool = data;
+
+    eina_lock_take(&pool->lock);
+    while (1)
+    {
+        while (!pool->quit && (pool->next >= pool->count))
+            eina_condition_wait(&pool->cond_work);
+        if (pool->quit)
+            break;
+
+        _echart_thread_jobs_process(pool);
+    }
+    eina_lock_release(&pool->lock);
+
+    return NULL;
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+Eina_Bool
+echart_thread_init(void)
+{
+    Echart_Thread_Pool *pool;
+    int nbr;
+    int i;
+
+    pool = &_echart_thread_pool;
+    memset(pool, 0, sizeof(Echart_Thread_Pool));
+
+    if (!eina_lock_new(&pool->lock))
+        return EINA_FALSE;
+    if (!eina_condition_new(&pool->cond_work, &pool->lock))
+        goto free_lock;
+    if (!eina_condition_new(&pool->cond_done, &pool->lock))
+        goto free_cond_work;
+
+    /* the calling thread is a worker too */
+    nbr = eina_cpu_count() - 1;
+    if (nbr > ECHART_THREAD_MAX)
+        nbr = ECHART_THREAD_MAX;
+
+    for (i = 0; i < nbr; i++)
+    {
+        if (!eina_thread_create(&pool->threads[i], EINA_THREAD_NORMAL, -1,
+                                _echart_thread_worker, pool))
+        {
+            WRN("Could only create %d worker threads.", i);
+            break;
+        }
+        pool->nbr_threads++;
+    }
+
+    INF("%u worker threads", pool->nbr_threads);
+
+    return EINA_TRUE;
+
+  free_cond_work:
+    eina_condition_free(&pool->cond_work);
+  free_lock:
+    eina_lock_free(&pool->lock);
+
+    return EINA_FALSE;
+}
+
+void
+echart_thread_shutdown(void)
+{
+    Echart_Thread_Pool *pool;
+    unsigned int i;
+
+    pool = &_echart_thread_pool;
+
+    eina_lock_take(&pool->lock);
+    pool->quit = EINA_TRUE;
+    eina_condition_broadcast(&pool->cond_work);
+    eina_lock_release(&pool->lock);
+
+    for (i = 0; i < pool->nbr_threads; i++)
+        eina_thread_join(pool->threads[i]);
+    pool->nbr_threads = 0;
+
+    eina_condition_free(&pool->cond_done);
+    eina_condition_free(&pool->cond_work);
+    eina_lock_free(&pool->lock);
+}
+
+unsigned int
+echart_thread_count(void)
+{
+    return _echart_thread_pool.nbr_threads + 1;
+}
+
+/*
+ * Run job(data, idx) for idx in [0, count[ and return once all of them
+ * are finished. A nested call, or a call from a job, runs sequentially.
+ */
+void
+echart_thread_run(unsigned int count, Echart_Thread_Job_Cb job, void *data)
+{
+    Echart_Thread_Pool *pool;
+    unsigned int i;
+
+    if (!count)
+        return;
+
+    pool = &_echart_thread_pool;
+
+    if ((count > 1) && pool->nbr_threads)
+    {
+        eina_lock_take(&pool->lock);
+        if (!pool->busy)
+        {
+            pool->busy = EINA_TRUE;
+            pool->job = job;
+            pool->data = data;
+            pool->count = count;
+            pool->next = 0;
+            pool->done = 0;
+            eina_condition_broadcast(&pool->cond_work);
+
+            _echart_thread_jobs_process(pool);
+            while (pool->done < pool->count)
+                eina_condition_wait(&pool->cond_done);
+
+            pool->count = 0;
+            pool->next = 0;
+            pool->busy = EINA_FALSE;
+            eina_lock_release(&pool->lock);
+            return;
+        }
+        eina_lock_release(&pool->lock);
+    }
+
+    for (i = 0; i < count; i++)
+        job(data, i);
+}
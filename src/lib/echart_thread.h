@@ -0,0 +1,32 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_THREAD_H
+#define ECHART_THREAD_H
+
+typedef void (*Echart_Thread_Job_Cb)(void *data, unsigned int idx);
+
+Eina_Bool echart_thread_init(void);
+
+void echart_thread_shutdown(void);
+
+unsigned int echart_thread_count(void);
+
+void echart_thread_run(unsigned int count, Echart_Thread_Job_Cb job, void *data);
+
+#endif /* ECHART_THREAD_H */
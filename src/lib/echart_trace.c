@@ -0,0 +1,236 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include "Echart.h"
+#include "echart_private.h"
+#include "echart_stats.h"
+#include "echart_trace.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+#ifdef ECHART_TRACE
+
+/* events kept per thread */
+#define ECHART_TRACE_EVENTS 65536
+
+/* the names are static strings, like __FUNCTION__ */
+typedef struct
+{
+    const char *name;
+    double t;
+    char phase;
+} Echart_Trace_Event;
+
+/*
+ * Ring buffer of a thread, created at its first event. Only the thread
+ * writes in it, so recording an event takes no lock.
+ */
+typedef struct
+{
+    Echart_Trace_Event events[ECHART_TRACE_EVENTS];
+    unsigned int next;
+    unsigned int count;
+    unsigned int tid;
+} Echart_Trace_Buffer;
+
+static Eina_TLS _echart_trace_key;
+static Eina_Lock _echart_trace_lock;
+static Eina_List *_echart_trace_buffers = NULL; /* all the threads */
+static unsigned int _echart_trace_tid = 0;
+static double _echart_trace_t0 = 0;
+
+static Echart_Trace_Buffer *
+_echart_trace_buffer_get(void)
+{
+    Echart_Trace_Buffer *b;
+
+    b = eina_tls_get(_echart_trace_key);
+    if (b)
+        return b;
+
+    b = (Echart_Trace_Buffer *)calloc(1, sizeof(Echart_Trace_Buffer));
+    if (!b)
+        return NULL;
+
+    eina_lock_take(&_echart_trace_lock);
+    b->tid = ++_echart_trace_tid;
+    _echart_trace_buffers = eina_list_append(_echart_trace_buffers, b);
+    eina_lock_release(&_echart_trace_lock);
+
+    eina_tls_set(_echart_trace_key, b);
+
+    return b;
+}
+
+#endif
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+#ifdef ECHART_TRACE
+
+Eina_Bool
+echart_trace_init(void)
+{
+    if (!eina_lock_new(&_echart_trace_lock))
+        return EINA_FALSE;
+
+    if (!eina_tls_new(&_echart_trace_key))
+    {
+        eina_lock_free(&_echart_trace_lock);
+        return EINA_FALSE;
+    }
+
+    _echart_trace_t0 = echart_stats_time_get();
+
+    return EINA_TRUE;
+}
+
+void
+echart_trace_shutdown(void)
+{
+    Echart_Trace_Buffer *b;
+
+    EINA_LIST_FREE(_echart_trace_buffers, b)
+        free(b);
+    _echart_trace_tid = 0;
+
+    eina_tls_free(_echart_trace_key);
+    eina_lock_free(&_echart_trace_lock);
+}
+
+void
+echart_trace_event(const char *name, char phase)
+{
+    Echart_Trace_Buffer *b;
+    Echart_Trace_Event *e;
+
+    b = _echart_trace_buffer_get();
+    if (!b)
+        return;
+
+    e = b->events + b->next;
+    e->name = name;
+    e->t = echart_stats_time_get();
+    e->phase = phase;
+
+    b->next = (b->next + 1) % ECHART_TRACE_EVENTS;
+    if (b->count < ECHART_TRACE_EVENTS)
+        b->count++;
+}
+
+const char *
+echart_trace_scope_begin(const char *name)
+{
+    echart_trace_event(name, 'B');
+
+    return name;
+}
+
+void
+echart_trace_scope_end(const char **name)
+{
+    echart_trace_event(*name, 'E');
+}
+
+#endif
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Eina_Bool
+echart_trace_dump(const char *file)
+{
+#ifdef ECHART_TRACE
+    const Echart_Trace_Buffer *b;
+    const Eina_List *l;
+    FILE *f;
+    Eina_Bool first;
+
+    EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+
+    f = fopen(file, "wb");
+    if (!f)
+    {
+        ERR("Could not open %s.", file);
+        return EINA_FALSE;
+    }
+
+    fprintf(f, "{\"traceEvents\":[\n");
+
+    first = EINA_TRUE;
+    eina_lock_take(&_echart_trace_lock);
+    EINA_LIST_FOREACH(_echart_trace_buffers, l, b)
+    {
+        unsigned int i;
+        unsigned int idx;
+
+        /* from the oldest event */
+        idx = (b->next + ECHART_TRACE_EVENTS - b->count) % ECHART_TRACE_EVENTS;
+        for (i = 0; i < b->count; i++)
+        {
+            const Echart_Trace_Event *e;
+
+            e = b->events + idx;
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                    first ? "" : ",\n",
+                    e->name, e->phase,
+                    (e->t - _echart_trace_t0) * 1000000.0,
+                    b->tid);
+            first = EINA_FALSE;
+            idx = (idx + 1) % ECHART_TRACE_EVENTS;
+        }
+    }
+    eina_lock_release(&_echart_trace_lock);
+
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    if (fclose(f) != 0)
+    {
+        ERR("Could not write %s.", file);
+        return EINA_FALSE;
+    }
+
+    return EINA_TRUE;
+#else
+    (void)file;
+
+    return EINA_FALSE;
+#endif
+}
@@ -0,0 +1,68 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ECHART_TRACE_H
+#define ECHART_TRACE_H
+
+/*
+ * Write the trace events recorded by the threads in file, in the
+ * Chrome trace event format (chrome://tracing, Perfetto). It returns
+ * EINA_FALSE if the library is built without the trace option. It is
+ * meant to be called when no chart is being calculated.
+ */
+EAPI Eina_Bool echart_trace_dump(const char *file);
+
+/*
+ * Trace points. Without ECHART_TRACE (meson option 'trace'), they
+ * expand to nothing. With it, each thread records the begin and end
+ * events in its own ring buffer, the oldest events being overwritten.
+ * ECHART_TRACE_SCOPE() declares a variable: it must be put after the
+ * declarations of the block, and its end event is recorded when the
+ * block is left, whatever the return.
+ */
+#ifdef ECHART_TRACE
+
+# define ECHART_TRACE_BEGIN(name_) echart_trace_event(name_, 'B')
+# define ECHART_TRACE_END(name_) echart_trace_event(name_, 'E')
+# define ECHART_TRACE_SCOPE(name_) \
+    const char *_echart_trace_scope \
+    __attribute__((cleanup(echart_trace_scope_end))) = \
+    echart_trace_scope_begin(name_)
+
+Eina_Bool echart_trace_init(void);
+
+void echart_trace_shutdown(void);
+
+void echart_trace_event(const char *name, char phase);
+
+const char *echart_trace_scope_begin(const char *name);
+
+void echart_trace_scope_end(const char **name);
+
+#else
+
+# define ECHART_TRACE_BEGIN(name_)
+# define ECHART_TRACE_END(name_)
+# define ECHART_TRACE_SCOPE(name_)
+
+# define echart_trace_init() EINA_TRUE
+# define echart_trace_shutdown()
+
+#endif
+
+#endif /* ECHART_TRACE_H */
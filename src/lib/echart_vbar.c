@@ -32,7 +32,10 @@
 #include "echart_data.h"
 #include "echart_chart.h"
 #include "echart_common.h"
+#include "echart_text.h"
+#include "echart_raster.h"
 #include "echart_vbar.h"
+#include "echart_trace.h"
 
 /*============================================================================*
  *                                  Local                                     *
@@ -66,10 +69,62 @@
 
 #define ECHART_VBAR_OBJ_NAME "echart_vbar_object"
 
+/* layout of the groups in the last frame, for the hovered group */
+typedef struct
+{
+    double vxmin; /* window of the frame */
+    double vxmax;
+    double ymin;
+    double ymax;
+    double x0; /* the group i starts at x0 + i * dx and is L wide */
+    double dx;
+    double L;
+    unsigned int nbr;
+    Evas_Coord left; /* position of the plot in the canvas */
+    Evas_Coord top;
+    Eina_Bool valid;
+} Echart_Vbar_Layout;
+
+/* bar of the raster backend, in the units of the data */
+typedef struct
+{
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+    unsigned int color;
+} Echart_Vbar_Rect;
+
+/* values of the groups, written with the decimals of their spacing */
+typedef struct
+{
+    const double *xv;
+    int decimals;
+} Echart_Vbar_Absc;
+
 typedef struct
 {
     Echart_Smart_Common common;
     double group_width;
+    Eina_Inarray *absc; /* labels of the groups */
+    int absc_decimals;
+    Echart_Vbar_Layout layout;
+    /*
+     * The bars built in the last layout, reused by a frame with only a
+     * resize: the VG backend scales their container from the plot size
+     * they were built for, the raster backend fills them again.
+     */
+    Efl_VG *axis;
+    Efl_VG *grid;
+    Efl_VG *bars;
+    Evas_Coord built_w;
+    Evas_Coord built_h;
+    Echart_Vbar_Rect *rects;
+    unsigned int nbr_rects;
+    unsigned int rects_size;
+    Eina_Bool built : 1;
+    Efl_VG *highlight; /* hovered group, in the overlay */
+    int hovered; /* -1 if none */
 } Echart_Smart_Data;
 
 static Evas_Smart *_echart_vbar_smart = NULL;
@@ -85,133 +140,12 @@ _echart_vbar_coords_get(const Echart_Smart_Data *sd,
     *yvg = sd->common.padding + (sd->common.h_vg - 2 * sd->common.padding) * (ymax - y) / (ymax - ymin);
 }
 
-static void
-_echart_vbar_mouse_move_cb(void *d, Evas *evas EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event)
-{
-    Echart_Smart_Data *sd;
-    Evas_Event_Mouse_Move *ev;
-    const Echart_Data *data;
-    const Echart_Serie *absciss;
-    const Echart_Serie *serie;
-    const Eina_List *series;
-    const Eina_List *l;
-    const Eina_Inarray *x_values;
-    Echart_Colors cols;
-    Echart_Offsets offsets;
-    Evas_Coord xd;
-    Evas_Coord yd;
-    double *xv;
-    double ymin;
-    double ymax;
-    int n;
-
-    sd = d;
-    ev = event;
-
-    echart_offsets_get(sd->common.title, &offsets);
-
-    data = echart_chart_data_get(sd->common.chart);
-    absciss = echart_data_absciss_get(data);
-    series = echart_data_series_get(data);
-
-    x_values = echart_serie_values_get(absciss);
-    xv = (double *)x_values->members;
-
-    echart_data_interval_get(data, &ymin, &ymax);
-    n = (int)floor(log(ymax - ymin) / log(10));
-    ymax = (floor(ymax / pow(10, n - 1)) + 1) * pow(10, n - 1);
-
-
-    EINA_LIST_FOREACH(series, l, serie)
-    {
-        const Eina_Inarray *y_values;
-        double *yv;
-        Evas_Coord x;
-        Evas_Coord y;
-        size_t i;
-
-        y_values = echart_serie_values_get(serie);
-        yv = (double *)y_values->members;
-
-        for (i = 0; i < x_values->len; i++)
-        {
-            _echart_vbar_coords_get(sd,
-                                    xv[0], xv[x_values->len - 1],
-                                    ymin, ymax,
-                                    xv[i], yv[i],
-                                    &x, &y);
-            if ((ev->cur.canvas.x >= (x + offsets.left - 3)) &&
-                (ev->cur.canvas.x <= (x + offsets.left + 3)) &&
-                (ev->cur.canvas.y >= (y + offsets.top - 3)) &&
-                (ev->cur.canvas.y <= (y + offsets.top + 3)))
-            {
-            }
-
-        }
-    }
-
-    /* if (has_dot) */
-    /* { */
-    /*     if (!sd->dot) */
-    /*     { */
-    /*         sd->dot = evas_vg_shape_add(sd->root); */
-    /*         evas_vg_shape_append_circle(sd->dot, xd, yd, 5); */
-    /*         evas_vg_node_color_set(sd->dot, */
-    /*                                COL_TO_R(cols.line), */
-    /*                                COL_TO_G(cols.line), */
-    /*                                COL_TO_B(cols.line), */
-    /*                                COL_TO_A(cols.line)); */
-    /*     } */
-    /* } */
-    /* else */
-    /* { */
-    /*     evas_vg_shape_reset(sd->dot); */
-    /*     sd->dot = NULL; */
-    /* } */
-}
-
-static void
-_echart_text_object_set(Evas_Object *obj,
-                        const char *text,
-                        const Echart_Font_Style *fs)
-{
-    char buf[256];
-    char buf2[32];
-
-    if (!text)
-        return;
-
-    *buf2 = '\0';
-    if (fs->bold || fs->italic)
-    {
-        memcpy(buf2, ":style=", 7);
-        if (!fs->italic)
-            memcpy(buf2 + 7, "Bold", 5);
-        else if (!fs->bold)
-            memcpy(buf2 + 7, "Italic", 7);
-        else
-            memcpy(buf2 + 7, "Bold Italic", 12);
-    }
-    snprintf(buf, sizeof(buf), "%s%s",
-             fs->font_name ? fs->font_name : "Sans", buf2);
-    buf[255] = '\0';
-
-    evas_object_text_style_set(obj, EVAS_TEXT_STYLE_PLAIN);
-    evas_object_color_set(obj,
-                          COL_TO_R(fs->font_color),
-                          COL_TO_G(fs->font_color),
-                          COL_TO_B(fs->font_color),
-                          COL_TO_A(fs->font_color));
-    evas_object_text_font_set(obj, buf, (fs->font_size <= 0) ? 13 : fs->font_size);
-    evas_object_text_text_set(obj, text);
-}
-
 static void
 _echart_vbar_smart_add(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = calloc(1, sizeof(Echart_Smart_Data));
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -223,11 +157,17 @@ _echart_vbar_smart_add(Evas_Object *obj)
     sd->common.vg = evas_object_vg_add(evas_object_evas_get(obj));
     sd->common.root = evas_vg_container_add(sd->common.vg);
     evas_object_vg_root_node_set(sd->common.vg, sd->common.root);
+    sd->common.img = evas_object_image_filled_add(evas_object_evas_get(obj));
+    echart_overlay_add((Echart_Smart_Common *)sd, evas_object_evas_get(obj));
+    sd->highlight = evas_vg_shape_add(sd->common.overlay_root);
+    evas_vg_node_visible_set(sd->highlight, EINA_FALSE);
+    sd->hovered = -1;
 
+    sd->absc = eina_inarray_new(sizeof(Evas_Object *), 0);
     sd->group_width = 0.6180339887; /* golden number^-1 */
 
-    evas_object_event_callback_add(sd->common.vg, EVAS_CALLBACK_MOUSE_MOVE,
-                                   _echart_vbar_mouse_move_cb, sd);
+    echart_pointer_callbacks_add((Echart_Smart_Common *)sd, obj);
+    sd->common.need_layout = EINA_TRUE;
 
     evas_object_smart_data_set(obj, sd);
 }
@@ -237,16 +177,25 @@ _echart_vbar_smart_del(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     EINA_REFCOUNT_UNREF((Echart_Smart_Common *)sd)
     {
+        Evas_Object **t;
+
+        EINA_INARRAY_FOREACH(sd->absc, t)
+            evas_object_del(*t);
+        eina_inarray_free(sd->absc);
+        free(sd->rects);
+        free(sd->common.stack);
         evas_object_del(sd->common.bg);
         evas_object_del(sd->common.title);
         evas_object_del(sd->common.vg);
+        evas_object_del(sd->common.img);
+        evas_object_del(sd->common.overlay);
         free(sd);
     }
 }
@@ -255,12 +204,13 @@ static void
 _echart_vbar_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
     Evas_Coord ox;
     Evas_Coord oy;
     Evas_Coord dx;
     Evas_Coord dy;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -275,6 +225,17 @@ _echart_vbar_smart_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
     evas_object_move(sd->common.title, ox + dx, oy + dy);
     evas_object_geometry_get(sd->common.vg, &ox, &oy, NULL, NULL);
     evas_object_move(sd->common.vg, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.img, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.img, ox + dx, oy + dy);
+    evas_object_geometry_get(sd->common.overlay, &ox, &oy, NULL, NULL);
+    evas_object_move(sd->common.overlay, ox + dx, oy + dy);
+    sd->layout.left += dx;
+    sd->layout.top += dy;
+    EINA_INARRAY_FOREACH(sd->absc, t)
+    {
+        evas_object_geometry_get(*t, &ox, &oy, NULL, NULL);
+        evas_object_move(*t, ox + dx, oy + dy);
+    }
 }
 
 static void
@@ -282,29 +243,31 @@ _echart_vbar_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
 {
     Echart_Smart_Data *sd;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
-    /* FIXME: manage resize */
-
-    fprintf(stderr, " %s 2 : %dx%d\n", __FUNCTION__, w, h);
+    /* the bars are only scaled, at the next frame */
+    echart_object_resize((Echart_Smart_Common *)sd, obj, w, h);
 }
 
 static void
 _echart_vbar_smart_show(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
 
     evas_object_show(sd->common.bg);
     evas_object_show(sd->common.title);
-    evas_object_show(sd->common.vg);
+    EINA_INARRAY_FOREACH(sd->absc, t)
+        evas_object_show(*t);
+    echart_backend_set((Echart_Smart_Common *)sd, EINA_TRUE);
 
 }
 
@@ -312,8 +275,9 @@ static void
 _echart_vbar_smart_hide(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -321,14 +285,19 @@ _echart_vbar_smart_hide(Evas_Object *obj)
     evas_object_hide(sd->common.bg);
     evas_object_hide(sd->common.title);
     evas_object_hide(sd->common.vg);
+    evas_object_hide(sd->common.img);
+    evas_object_hide(sd->common.overlay);
+    EINA_INARRAY_FOREACH(sd->absc, t)
+        evas_object_hide(*t);
 }
 
 static void
 _echart_vbar_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -336,14 +305,19 @@ _echart_vbar_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
     evas_object_clip_set(sd->common.bg, clip);
     evas_object_clip_set(sd->common.title, clip);
     evas_object_clip_set(sd->common.vg, clip);
+    evas_object_clip_set(sd->common.img, clip);
+    evas_object_clip_set(sd->common.overlay, clip);
+    EINA_INARRAY_FOREACH(sd->absc, t)
+        evas_object_clip_set(*t, clip);
 }
 
 static void
 _echart_vbar_smart_clip_unset(Evas_Object *obj)
 {
     Echart_Smart_Data *sd;
+    Evas_Object **t;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
+    ECHART_TRACE_SCOPE(__FUNCTION__);
 
     sd = evas_object_smart_data_get(obj);
     EINA_SAFETY_ON_NULL_RETURN(sd);
@@ -351,47 +325,299 @@ _echart_vbar_smart_clip_unset(Evas_Object *obj)
     evas_object_clip_unset(sd->common.bg);
     evas_object_clip_unset(sd->common.title);
     evas_object_clip_unset(sd->common.vg);
+    evas_object_clip_unset(sd->common.img);
+    evas_object_clip_unset(sd->common.overlay);
+    EINA_INARRAY_FOREACH(sd->absc, t)
+        evas_object_clip_unset(*t);
+}
+
+/*
+ * Groups of bars [first, last] intersecting the window [wxmin, wxmax],
+ * the group i starting at x0 + i * dx and being L wide.
+ */
+static Eina_Bool
+_echart_vbar_visible_get(unsigned int nbr,
+                         double x0, double dx, double L,
+                         double wxmin, double wxmax,
+                         unsigned int *first, unsigned int *last)
+{
+    double f;
+    double e;
+
+    if (!nbr || (dx <= 0))
+        return EINA_FALSE;
+
+    f = ceil((wxmin - L - x0) / dx);
+    e = floor((wxmax - x0) / dx);
+    if (f < 0)
+        f = 0;
+    if (e > nbr - 1)
+        e = nbr - 1;
+    if (f > e)
+        return EINA_FALSE;
+
+    *first = (unsigned int)f;
+    *last = (unsigned int)e;
+
+    return EINA_TRUE;
 }
 
 static void
-_echart_vbar_add(const Echart_Smart_Data *sd,
-                 const Eina_List *series,
-                 unsigned int i,
-                 unsigned int idx,
-                 double xmin,
-                 double xmax,
-                 double ymin,
-                 double ymax,
-                 double x,
-                 double L)
+_echart_vbar_absc_text_get(const void *data, unsigned int i,
+                           char *buf, size_t size)
+{
+    const Echart_Vbar_Absc *absc;
+
+    absc = data;
+    echart_scale_format(absc->xv[i], absc->decimals, buf, size);
+}
+
+/* height of the labels of the groups, to keep room under the plot */
+static Evas_Coord
+_echart_vbar_absc_height_get(Echart_Smart_Data *sd, Evas_Object *obj)
+{
+    Echart_Font_Style fs;
+    const Echart_Data *data;
+    const Eina_Inarray *x_values;
+    Echart_Vbar_Absc absc;
+    Evas_Coord h;
+    int d;
+    char buf[128];
+
+    data = echart_chart_data_get(sd->common.chart);
+    x_values = echart_serie_values_get(echart_data_absciss_get(data));
+    if (!x_values || !x_values->len)
+    {
+        echart_labels_count_set(sd->absc, 0);
+        return 0;
+    }
+
+    /*
+     * the values are expected to be evenly spaced, so the first one and
+     * the spacing give the decimals of all of them
+     */
+    absc.xv = (const double *)x_values->members;
+    absc.decimals = echart_scale_decimals_get(absc.xv[0]);
+    if (x_values->len > 1)
+    {
+        d = echart_scale_decimals_get((absc.xv[x_values->len - 1] - absc.xv[0]) /
+                                      (x_values->len - 1));
+        if (d > absc.decimals)
+            absc.decimals = d;
+    }
+    sd->absc_decimals = absc.decimals;
+
+    echart_chart_title_haxis_style_get(sd->common.chart, &fs);
+    _echart_vbar_absc_text_get(&absc, 0, buf, sizeof(buf));
+    if (!echart_text_size_get(buf, &fs, NULL, &h))
+        echart_text_object_set(echart_label_object_get(sd->absc, obj, 0),
+                               buf, &fs, NULL, &h);
+
+    return h;
+}
+
+/*
+ * Labels of the visible groups, under the plot. With many groups, only
+ * one group every stride groups is labelled, so that the labels do not
+ * overlap, and the number of text objects is bounded by the width of
+ * the plot.
+ */
+static void
+_echart_vbar_absc_set(Echart_Smart_Data *sd, Evas_Object *obj,
+                      double vxmin, double vxmax)
+{
+    Echart_Font_Style fs;
+    Echart_Offsets offsets;
+    const Echart_Data *data;
+    const Eina_Inarray *x_values;
+    const double *xv;
+    Echart_Vbar_Absc absc;
+    double ax;
+    double l;
+    double L;
+    unsigned int stride;
+    unsigned int first;
+    unsigned int last;
+    unsigned int nbr;
+    unsigned int i;
+
+    data = echart_chart_data_get(sd->common.chart);
+    x_values = echart_serie_values_get(echart_data_absciss_get(data));
+    if (!x_values || !x_values->len)
+    {
+        echart_labels_count_set(sd->absc, 0);
+        return;
+    }
+
+    xv = (const double *)x_values->members;
+    l = (1 - sd->group_width) * (xv[x_values->len - 1] - xv[0]) / (x_values->len + 1);
+    L = sd->group_width * (xv[x_values->len - 1] - xv[0]) / x_values->len;
+    if (!_echart_vbar_visible_get(x_values->len, xv[0] + l, l + L, L,
+                                  vxmin, vxmax, &first, &last))
+    {
+        echart_labels_count_set(sd->absc, 0);
+        return;
+    }
+
+    absc.xv = xv;
+    absc.decimals = sd->absc_decimals;
+
+    echart_offsets_get(sd->common.title, &offsets);
+    echart_chart_title_haxis_style_get(sd->common.chart, &fs);
+    ax = (sd->common.w_vg - 2 * sd->common.padding) / (vxmax - vxmin);
+    stride = echart_labels_stride_get(sd->absc, obj, &fs,
+                                      _echart_vbar_absc_text_get, &absc,
+                                      first, last, (l + L) * ax,
+                                      EINA_FALSE);
+
+    /* the labelled groups do not depend on the window */
+    nbr = 0;
+    for (i = ((first + stride - 1) / stride) * stride; i <= last; i += stride)
+    {
+        char buf[128];
+        Evas_Object *o;
+        Evas_Coord w;
+        double x;
+
+        x = PAD(0) + ax * (xv[0] + l + i * (l + L) + L / 2 - vxmin);
+        if ((x < 0) || (x > sd->common.w_vg))
+            continue;
+
+        o = echart_label_object_get(sd->absc, obj, nbr++);
+        _echart_vbar_absc_text_get(&absc, i, buf, sizeof(buf));
+        echart_text_object_set(o, buf, &fs, &w, NULL);
+        evas_object_move(o, offsets.left + x - w / 2,
+                         offsets.top + sd->common.h_vg);
+    }
+
+    echart_labels_count_set(sd->absc, nbr);
+}
+
+static void
+_echart_vbar_layout_set(Echart_Smart_Data *sd,
+                        double vxmin, double vxmax,
+                        double ymin, double ymax)
+{
+    const Echart_Data *data;
+    const Eina_Inarray *x_values;
+    const double *xv;
+    double l;
+    Evas_Coord x;
+    Evas_Coord y;
+
+    sd->layout.valid = EINA_FALSE;
+
+    data = echart_chart_data_get(sd->common.chart);
+    x_values = echart_serie_values_get(echart_data_absciss_get(data));
+    if (!x_values || !x_values->len || (vxmax <= vxmin))
+        return;
+
+    xv = (const double *)x_values->members;
+    l = (1 - sd->group_width) * (xv[x_values->len - 1] - xv[0]) / (x_values->len + 1);
+    sd->layout.L = sd->group_width * (xv[x_values->len - 1] - xv[0]) / x_values->len;
+    sd->layout.x0 = xv[0] + l;
+    sd->layout.dx = l + sd->layout.L;
+    sd->layout.nbr = x_values->len;
+    sd->layout.vxmin = vxmin;
+    sd->layout.vxmax = vxmax;
+    sd->layout.ymin = ymin;
+    sd->layout.ymax = ymax;
+    /* the plot has been placed by echart_vg_set() */
+    evas_object_geometry_get(sd->common.vg, &x, &y, NULL, NULL);
+    sd->layout.left = x;
+    sd->layout.top = y;
+    sd->layout.valid = sd->layout.dx > 0;
+}
+
+/* hovered group, at most once per frame, only the overlay is updated */
+static void
+_echart_vbar_pointer_update(Echart_Smart_Data *sd)
+{
+    double ax;
+    double x;
+    double f;
+    int hovered;
+
+    hovered = -1;
+    ax = 0;
+    if (sd->layout.valid && sd->common.pointer_in &&
+        (sd->common.pointer_y >= sd->layout.top + sd->common.padding) &&
+        (sd->common.pointer_y < sd->layout.top + sd->common.h_vg - sd->common.padding))
+    {
+        ax = (sd->common.w_vg - 2 * sd->common.padding) /
+             (sd->layout.vxmax - sd->layout.vxmin);
+        x = sd->layout.vxmin +
+            (sd->common.pointer_x - sd->layout.left - sd->common.padding) / ax;
+        f = floor((x - sd->layout.x0) / sd->layout.dx);
+        if ((f >= 0) && (f < sd->layout.nbr) &&
+            (x - sd->layout.x0 - f * sd->layout.dx <= sd->layout.L))
+            hovered = (int)f;
+    }
+
+    if (hovered == sd->hovered)
+        return;
+
+    sd->hovered = hovered;
+    if (hovered < 0)
+    {
+        evas_vg_node_visible_set(sd->highlight, EINA_FALSE);
+        return;
+    }
+
+    x = PAD(0) + ax * (sd->layout.x0 + hovered * sd->layout.dx - sd->layout.vxmin);
+    evas_vg_shape_reset(sd->highlight);
+    evas_vg_shape_append_rect(sd->highlight,
+                              x, PAD(0),
+                              ax * sd->layout.L, sd->common.h_vg - PAD2(0),
+                              0, 0);
+    /* premultiplied */
+    evas_vg_node_color_set(sd->highlight, 0, 0, 0, 32);
+    evas_vg_node_visible_set(sd->highlight, EINA_TRUE);
+}
+
+/*
+ * All the bars of a serie are the rectangles of a single shape, so that
+ * the number of nodes is the number of series, not of bars. The bar k
+ * goes from base[k], or ymin without base, to yv[k].
+ */
+static void
+_echart_vbar_serie_add(const Echart_Smart_Data *sd,
+                       const Echart_Serie *serie,
+                       const double *base,
+                       const double *yv,
+                       unsigned int n,
+                       double xmin,
+                       double xmax,
+                       double ymin,
+                       double ymax,
+                       double x,
+                       double dx,
+                       double L)
 {
     Efl_VG *r;
-    const Eina_Inarray *y_values;
-    const Echart_Serie *serie;
-    double *yv;
     Echart_Colors cols;
-    Evas_Coord xc;
-    Evas_Coord yc;
+    Evas_Coord xc0;
+    Evas_Coord xc1;
+    Evas_Coord yc0;
+    Evas_Coord yc1;
+    unsigned int i;
 
-    serie = (const Echart_Serie *)eina_list_nth(series, idx);
-    y_values = echart_serie_values_get(serie);
-    yv = (double *)y_values->members;
     cols = echart_serie_color_get(serie);
 
-    r = evas_vg_shape_add(sd->common.root);
-    _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
-                            x, ymin, &xc, &yc);
-    evas_vg_shape_append_move_to(r, xc, yc);
-    _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
-                            x, yv[i], &xc, &yc);
-    evas_vg_shape_append_line_to(r, xc, yc);
-    _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
-                            x + L, yv[i], &xc, &yc);
-    evas_vg_shape_append_line_to(r, xc, yc);
-    _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
-                            x + L, ymin, &xc, &yc);
-    evas_vg_shape_append_line_to(r, xc, yc);
-    evas_vg_shape_append_close(r);
+    r = evas_vg_shape_add(sd->bars);
+    for (i = 0; i < n; i++)
+    {
+        _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
+                                x, base ? base[i] : ymin, &xc0, &yc0);
+        _echart_vbar_coords_get(sd, xmin, xmax, ymin, ymax,
+                                x + L, yv[i], &xc1, &yc1);
+        evas_vg_shape_append_move_to(r, xc0, yc0);
+        evas_vg_shape_append_line_to(r, xc0, yc1);
+        evas_vg_shape_append_line_to(r, xc1, yc1);
+        evas_vg_shape_append_line_to(r, xc1, yc0);
+        evas_vg_shape_append_close(r);
+        x += dx;
+    }
     evas_vg_node_color_set(r,
                            COL_TO_R(cols.line),
                            COL_TO_G(cols.line),
@@ -399,40 +625,301 @@ _echart_vbar_add(const Echart_Smart_Data *sd,
                            COL_TO_A(cols.line));
 }
 
+/* room for nbr bars of the raster backend */
+static Eina_Bool
+_echart_vbar_rects_reserve(Echart_Smart_Data *sd, unsigned int nbr)
+{
+    Echart_Vbar_Rect *rects;
+
+    sd->nbr_rects = 0;
+    if (nbr <= sd->rects_size)
+        return EINA_TRUE;
+
+    rects = (Echart_Vbar_Rect *)realloc(sd->rects, nbr * sizeof(Echart_Vbar_Rect));
+    if (!rects)
+    {
+        ERR("Could not allocate the bars.");
+        return EINA_FALSE;
+    }
+    sd->rects = rects;
+    sd->rects_size = nbr;
+
+    return EINA_TRUE;
+}
+
 static void
-_echart_vbar_smart_calculate(Evas_Object *obj)
+_echart_vbar_rect_push(Echart_Smart_Data *sd,
+                       double x0, double y0, double x1, double y1,
+                       unsigned int color)
+{
+    Echart_Vbar_Rect *r;
+
+    r = sd->rects + sd->nbr_rects++;
+    r->x0 = x0;
+    r->y0 = y0;
+    r->x1 = x1;
+    r->y1 = y1;
+    r->color = color;
+}
+
+/* bars of the visible groups, for the raster backend */
+static void
+_echart_vbar_rects_set(Echart_Smart_Data *sd,
+                       double vxmin, double vxmax, double ymin)
+{
+    const Echart_Data *data;
+    const Echart_Serie *absciss;
+    const Echart_Serie *serie;
+    const Eina_List *series;
+    const Eina_List *ls;
+    const Eina_Inarray *x_values;
+    const double **yvs;
+    Echart_Colors *cols;
+    unsigned int *lens;
+    double *xv;
+    double xmin;
+    double xmax;
+    double x;
+    double l;
+    double L;
+    double bl;
+    unsigned int nbr_series;
+    unsigned int first;
+    unsigned int last;
+    unsigned int n;
+    unsigned int i;
+    unsigned int j;
+
+    sd->nbr_rects = 0;
+
+    data = echart_chart_data_get(sd->common.chart);
+    absciss = echart_data_absciss_get(data);
+    x_values = echart_serie_values_get(absciss);
+    series = echart_data_series_get(data);
+    nbr_series = eina_list_count(series);
+    if (!x_values || !x_values->len || !nbr_series)
+        return;
+
+    xv = (double *)x_values->members;
+    xmin = xv[0];
+    xmax = xv[x_values->len - 1];
+    l = (1 - sd->group_width) * (xmax - xmin) / (x_values->len + 1);
+    L = sd->group_width * (xmax - xmin) / x_values->len;
+    bl = L / nbr_series;
+    if (!_echart_vbar_visible_get(x_values->len, xmin + l, l + L, L,
+                                  vxmin, vxmax, &first, &last))
+        return;
+
+    n = last - first + 1;
+    if (!_echart_vbar_rects_reserve(sd, nbr_series * n))
+        return;
+
+    /* values, colors and lengths of the series, indexed once */
+    yvs = (const double **)malloc(nbr_series * (sizeof(double *) + sizeof(Echart_Colors) + sizeof(unsigned int)));
+    if (!yvs)
+        return;
+    cols = (Echart_Colors *)(yvs + nbr_series);
+    lens = (unsigned int *)(cols + nbr_series);
+    j = 0;
+    EINA_LIST_FOREACH(series, ls, serie)
+    {
+        const Eina_Inarray *y_values;
+
+        y_values = echart_serie_values_get(serie);
+        yvs[j] = y_values ? (const double *)y_values->members : NULL;
+        lens[j] = y_values ? y_values->len : 0;
+        cols[j] = echart_serie_color_get(serie);
+        j++;
+    }
+
+    /* stacked, one bar per group, from the previous serie */
+    if (echart_data_stacked_get(data))
+    {
+        const double *stack;
+
+        stack = echart_stack_get((Echart_Smart_Common *)sd, series,
+                                 first, last);
+        if (stack)
+        {
+            x = xmin + l + first * (l + L);
+            for (i = 0; i < n; i++)
+            {
+                for (j = 0; j < nbr_series; j++)
+                    _echart_vbar_rect_push(sd,
+                                           x, j ? stack[(j - 1) * n + i] : ymin,
+                                           x + L, stack[j * n + i],
+                                           cols[j].line);
+                x += l + L;
+            }
+        }
+
+        free(yvs);
+        return;
+    }
+
+    x = xmin + l + first * (l + L);
+    for (i = first; i <= last; i++)
+    {
+        double bx;
+
+        bx = x;
+        for (j = 0; j < nbr_series; j++)
+        {
+            /* like the VG backend, a serie shorter than the groups is not drawn */
+            if (lens[j] > last)
+                _echart_vbar_rect_push(sd,
+                                       bx, ymin, bx + bl, yvs[j][i],
+                                       cols[j].line);
+            bx += bl;
+        }
+
+        x += l + L;
+    }
+
+    free(yvs);
+}
+
+/* axis, grid and bars of the raster backend, at the size of the plot */
+static void
+_echart_vbar_raster_draw(Echart_Smart_Data *sd,
+                         double vxmin, double vxmax,
+                         double ymin, double ymax)
+{
+    Echart_Raster r;
+    Echart_Raster_Transform t;
+    const Echart_Vbar_Rect *rect;
+    unsigned int col;
+    int gyn;
+    unsigned int i;
+
+    if (!echart_raster_begin(&r, sd->common.img,
+                             sd->common.w_vg, sd->common.h_vg))
+        return;
+
+    echart_raster_clear(&r, 0x00000000);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+
+    /* axis */
+    echart_raster_rect_fill(&r,
+                            PAD(0), PAD(0),
+                            PAD(1), sd->common.h_vg - PAD(0),
+                            0xff000000);
+    echart_raster_rect_fill(&r,
+                            PAD(0), sd->common.h_vg - PAD(1),
+                            sd->common.w_vg - PAD(0), sd->common.h_vg - PAD(0),
+                            0xff000000);
+
+    /* grid */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (gyn > 0)
+    {
+        for (i = 1; i <= (unsigned int)gyn; i++)
+        {
+            double y = i * (ymax - ymin) / gyn + ymin;
+            int k = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+            echart_raster_rect_fill(&r,
+                                    PAD(0.5), k + PAD(0),
+                                    sd->common.w_vg - PAD2(0.5), k + PAD(1),
+                                    col);
+        }
+    }
+
+    echart_raster_transform_set(&t,
+                                vxmin, vxmax,
+                                ymin, ymax,
+                                sd->common.padding, sd->common.padding,
+                                sd->common.w_vg - 2 * sd->common.padding,
+                                sd->common.h_vg - 2 * sd->common.padding);
+
+    rect = sd->rects;
+    for (i = 0; i < sd->nbr_rects; i++, rect++)
+        echart_raster_rect_fill(&r,
+                                t.ax * rect->x0 + t.bx,
+                                t.ay * rect->y0 + t.by,
+                                t.ax * rect->x1 + t.bx,
+                                t.ay * rect->y1 + t.by,
+                                rect->color);
+
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+    echart_raster_end(&r, sd->common.img);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+}
+
+/* axis and grid of the VG backend, at the size of the plot */
+static void
+_echart_vbar_frame_set(Echart_Smart_Data *sd, double ymin, double ymax)
+{
+    unsigned int col;
+    int gyn;
+    unsigned int i;
+
+    /* axis */
+    if (!sd->axis)
+    {
+        sd->axis = evas_vg_shape_add(sd->common.root);
+        evas_vg_shape_stroke_width_set(sd->axis, 1);
+        evas_vg_shape_stroke_color_set(sd->axis, 0, 0, 0, 255);
+    }
+    else
+        evas_vg_shape_reset(sd->axis);
+    evas_vg_shape_append_move_to(sd->axis, PAD(0.5), PAD(0.5));
+    evas_vg_shape_append_line_to(sd->axis, PAD(0.5), sd->common.h_vg - PAD(0.5));
+    evas_vg_shape_append_line_to(sd->axis, sd->common.w_vg - PAD(0.5), sd->common.h_vg - PAD(0.5));
+
+    /* grid, a single shape */
+    col = echart_chart_grid_color_get(sd->common.chart);
+    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
+    if (!sd->grid)
+    {
+        sd->grid = evas_vg_shape_add(sd->common.root);
+        evas_vg_shape_stroke_width_set(sd->grid, 1);
+        evas_vg_shape_stroke_color_set(sd->grid,
+                                       COL_TO_R(col), COL_TO_G(col), COL_TO_B(col), COL_TO_A(col));
+    }
+    else
+        evas_vg_shape_reset(sd->grid);
+    for (i = 1; (gyn > 0) && (i <= (unsigned int)gyn); i++)
+    {
+        double y = i * (ymax - ymin) / gyn + ymin;
+        int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
+        evas_vg_shape_append_move_to(sd->grid, PAD(0.5), j + PAD(0.5));
+        evas_vg_shape_append_line_to(sd->grid, sd->common.w_vg - PAD2(0.5), j + PAD(0.5));
+    }
+}
+
+static void
+_echart_vbar_layout_update(Evas_Object *obj, Echart_Smart_Data *sd)
 {
     Echart_Font_Style fs;
     const Echart_Data *data;
     const Echart_Serie *absciss;
+    const Echart_Serie *serie;
     const Eina_List *series;
+    const Eina_List *ls;
     const Eina_Inarray *x_values;
-    Echart_Smart_Data *sd;
     unsigned int col;
-    Efl_VG *vbar;
     double *xv;
     double xmin;
     double xmax;
+    double vxmin;
+    double vxmax;
     double ymin;
     double ymax;
     double x;
     double l;
     double L;
-    int gyn;
+    double bl;
     int w;
     int h;
-    int n;
     unsigned int nbr_series;
+    unsigned int first;
+    unsigned int last;
     unsigned int i;
 
-    fprintf(stderr, " ** %s\n", __FUNCTION__);
-
-    sd = evas_object_smart_data_get(obj);
-    EINA_SAFETY_ON_NULL_RETURN(sd);
-
     sd->common.padding = 5;
 
-    echart_chart_size_get(sd->common.chart, &w, &h);
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
     col = echart_chart_background_color_get(sd->common.chart);
 
     /* background */
@@ -444,82 +931,227 @@ _echart_vbar_smart_calculate(Evas_Object *obj)
         Evas_Coord w_title;
 
         echart_chart_title_style_get(sd->common.chart, &fs);
-        _echart_text_object_set(sd->common.title,
-                                echart_chart_title_get(sd->common.chart),
-                                &fs);
-        evas_object_geometry_get(sd->common.title, NULL, NULL, &w_title, NULL);
+        echart_text_object_set(sd->common.title,
+                               echart_chart_title_get(sd->common.chart),
+                               &fs, &w_title, NULL);
         evas_object_move(sd->common.title, (w - w_title) / 2, 0);
     }
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_BOUNDS);
 
     /* echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn); */
     /* if (gyn > 0) */
     /* { */
     /* } */
 
+    /* room for the labels of the groups */
+    sd->common.bottom = _echart_vbar_absc_height_get(sd, obj);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_LABELS);
+
     /* vg */
     echart_vg_set((Echart_Smart_Common *)sd);
+    echart_backend_set((Echart_Smart_Common *)sd, evas_object_visible_get(obj));
+    echart_vg_reset((Echart_Smart_Common *)sd);
+    sd->axis = NULL;
+    sd->grid = NULL;
+    sd->bars = NULL;
+    sd->built = EINA_FALSE;
+    sd->layout.valid = EINA_FALSE;
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_SUBMIT);
+
+    if (!echart_viewport_get((Echart_Smart_Common *)sd,
+                             &vxmin, &vxmax, &ymin, &ymax))
+        return;
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_BOUNDS);
+
+    _echart_vbar_absc_set(sd, obj, vxmin, vxmax);
+    sd->common.stats.stats.text_objects = 1 + eina_inarray_count(sd->absc);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_LABELS);
+    _echart_vbar_layout_set(sd, vxmin, vxmax, ymin, ymax);
+    sd->built = EINA_TRUE;
+
+    if (sd->common.backend == ECHART_BACKEND_RASTER)
+    {
+        _echart_vbar_rects_set(sd, vxmin, vxmax, ymin);
+        _echart_vbar_raster_draw(sd, vxmin, vxmax, ymin, ymax);
+        return;
+    }
+
+    _echart_vbar_frame_set(sd, ymin, ymax);
+
+    /* vbars, in a container scaled by a resize */
+    sd->bars = evas_vg_container_add(sd->common.root);
+    sd->built_w = sd->common.w_vg;
+    sd->built_h = sd->common.h_vg;
 
-    /* axis */
-    vbar = evas_vg_shape_add(sd->common.root);
-    evas_vg_shape_append_move_to(vbar, PAD(0.5), PAD(0.5));
-    evas_vg_shape_append_line_to(vbar, PAD(0.5), sd->common.h_vg - PAD(0.5));
-    evas_vg_shape_append_line_to(vbar, sd->common.w_vg - PAD(0.5), sd->common.h_vg - PAD(0.5));
-    evas_vg_shape_stroke_width_set(vbar, 1);
-    evas_vg_shape_stroke_color_set(vbar, 0, 0, 0, 255);
-
-    /* vbars */
     data = echart_chart_data_get(sd->common.chart);
     absciss = echart_data_absciss_get(data);
     x_values = echart_serie_values_get(absciss);
-    xv = (double *)x_values->members;
     series = echart_data_series_get(data);
     nbr_series = eina_list_count(series);
-
-    echart_data_interval_get(data, &ymin, &ymax);
-    n = (int)floor(log(ymax - ymin) / log(10));
-    ymax = (floor(ymax / pow(10, n - 1)) + 1) * pow(10, n - 1);
-    col = echart_chart_grid_color_get(sd->common.chart);
-
-    echart_chart_grid_nbr_get(sd->common.chart, NULL, &gyn);
-    if (gyn > 0)
-    {
-        for (i = 1; i <= (unsigned int)gyn; i++)
-        {
-            double y = i * (ymax - ymin) / gyn + ymin;
-            int j = (ymax - y) * (sd->common.h_vg - 1) / (ymax - ymin);
-            vbar = evas_vg_shape_add(sd->common.root);
-            evas_vg_shape_append_move_to(vbar, PAD(0.5), j + PAD(0.5));
-            evas_vg_shape_append_line_to(vbar, sd->common.w_vg - PAD2(0.5), j + PAD(0.5));
-            evas_vg_shape_stroke_width_set(vbar, 1);
-            evas_vg_shape_stroke_color_set(vbar,
-                                           COL_TO_R(col), COL_TO_G(col), COL_TO_B(col), COL_TO_A(col));
-        }
-    }
+    if (!x_values || !x_values->len || !nbr_series)
+        return;
+    xv = (double *)x_values->members;
 
     xmin = xv[0];
     xmax = xv[x_values->len - 1];
     l = (1 - sd->group_width) * (xmax - xmin) / (x_values->len + 1);
     L = sd->group_width * (xmax - xmin) / x_values->len;
-    x = xmin + l;
-    for (i = 0; i < x_values->len; i++)
+    bl = L / nbr_series;
+
+    /* only the groups in the window are drawn */
+    if (!_echart_vbar_visible_get(x_values->len, xmin + l, l + L, L,
+                                  vxmin, vxmax, &first, &last))
+        return;
+
+    /* a shape per serie, a rectangle per sample */
+    sd->common.stats.stats.points_in = nbr_series * (last - first + 1);
+    sd->common.stats.stats.points_out = sd->common.stats.stats.points_in;
+    sd->common.stats.stats.vg_nodes = 3 + nbr_series;
+
+    x = xmin + l + first * (l + L);
+    if (echart_data_stacked_get(data))
     {
-        double bx;
-        double bl;
-        unsigned int j;
+        const double *stack;
+        unsigned int n;
 
+        n = last - first + 1;
+        stack = echart_stack_get((Echart_Smart_Common *)sd, series,
+                                 first, last);
+        if (!stack)
+            return;
 
-        bl = L / nbr_series;
-        bx = x;
-        for (j = 0; j < nbr_series; j++)
+        i = 0;
+        EINA_LIST_FOREACH(series, ls, serie)
         {
-            _echart_vbar_add(sd, series, i, j,
-                             xmin, xmax, ymin, ymax,
-                             bx, bl);
-            bx += bl;
+            _echart_vbar_serie_add(sd, serie,
+                                   i ? stack + (i - 1) * n : NULL,
+                                   stack + i * n, n,
+                                   vxmin, vxmax, ymin, ymax,
+                                   x, l + L, L);
+            i++;
         }
+        return;
+    }
 
-        x += l + L;
+    EINA_LIST_FOREACH(series, ls, serie)
+    {
+        const Eina_Inarray *y_values;
+
+        y_values = echart_serie_values_get(serie);
+        if (y_values && (y_values->len > last))
+            _echart_vbar_serie_add(sd, serie, NULL,
+                                   (const double *)y_values->members + first,
+                                   last - first + 1,
+                                   vxmin, vxmax, ymin, ymax,
+                                   x, l + L, bl);
+        x += bl;
+    }
+}
+
+/*
+ * Frame with only a resize: the background, the title, the axis, the
+ * grid and the labels follow the new size, and the bars of the last
+ * layout are reused, without walking the data. Returns EINA_FALSE if
+ * there are none, a full layout being needed.
+ */
+static Eina_Bool
+_echart_vbar_resize_update(Evas_Object *obj, Echart_Smart_Data *sd)
+{
+    Eina_Matrix3 m;
+    double sx;
+    double sy;
+    int w;
+    int h;
+
+    if (!sd->built || !sd->layout.valid ||
+        (echart_chart_backend_get(sd->common.chart) != sd->common.backend))
+        return EINA_FALSE;
+
+    echart_size_get((Echart_Smart_Common *)sd, &w, &h);
+    echart_background_set((Echart_Smart_Common *)sd, w, h,
+                          echart_chart_background_color_get(sd->common.chart));
+    if (echart_chart_title_get(sd->common.chart))
+    {
+        Evas_Coord w_title;
+
+        evas_object_geometry_get(sd->common.title, NULL, NULL, &w_title, NULL);
+        evas_object_move(sd->common.title, (w - w_title) / 2, 0);
+    }
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_BOUNDS);
+
+    /* the height of the labels does not depend on the size */
+    echart_vg_set((Echart_Smart_Common *)sd);
+    _echart_vbar_absc_set(sd, obj, sd->layout.vxmin, sd->layout.vxmax);
+    sd->common.stats.stats.text_objects = 1 + eina_inarray_count(sd->absc);
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_LABELS);
+    _echart_vbar_layout_set(sd, sd->layout.vxmin, sd->layout.vxmax,
+                            sd->layout.ymin, sd->layout.ymax);
+
+    if (sd->common.backend == ECHART_BACKEND_RASTER)
+    {
+        _echart_vbar_raster_draw(sd, sd->layout.vxmin, sd->layout.vxmax,
+                                 sd->layout.ymin, sd->layout.ymax);
+        return EINA_TRUE;
+    }
+
+    _echart_vbar_frame_set(sd, sd->layout.ymin, sd->layout.ymax);
+    if (sd->bars &&
+        (sd->built_w > 2 * sd->common.padding) &&
+        (sd->built_h > 2 * sd->common.padding))
+    {
+        /* from the plot the bars were built for to the new one */
+        sx = (double)(sd->common.w_vg - 2 * sd->common.padding) /
+             (sd->built_w - 2 * sd->common.padding);
+        sy = (double)(sd->common.h_vg - 2 * sd->common.padding) /
+             (sd->built_h - 2 * sd->common.padding);
+        eina_matrix3_values_set(&m,
+                                sx, 0, sd->common.padding * (1 - sx),
+                                0, sy, sd->common.padding * (1 - sy),
+                                0, 0, 1);
+        evas_vg_node_transformation_set(sd->bars, &m);
+    }
+    echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_TRANSFORM);
+
+    return EINA_TRUE;
+}
+
+static void
+_echart_vbar_smart_calculate(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_TRACE_SCOPE(__FUNCTION__);
+
+    sd = evas_object_smart_data_get(obj);
+    EINA_SAFETY_ON_NULL_RETURN(sd);
+
+    echart_stats_frame_begin(&sd->common.stats,
+                             sd->common.need_layout || sd->common.need_resize);
+
+    /* called once per frame, see echart_object_changed() */
+    if (sd->common.need_layout || sd->common.need_resize)
+    {
+        /* a resize alone keeps the bars */
+        if (sd->common.need_layout ||
+            !_echart_vbar_resize_update(obj, sd))
+            _echart_vbar_layout_update(obj, sd);
+        sd->common.need_layout = EINA_FALSE;
+        sd->common.need_resize = EINA_FALSE;
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_PATH);
+        /* the groups may have moved */
+        sd->hovered = -1;
+        evas_vg_node_visible_set(sd->highlight, EINA_FALSE);
+        sd->common.pointer_changed = EINA_TRUE;
     }
+
+    if (sd->common.pointer_changed)
+    {
+        sd->common.pointer_changed = EINA_FALSE;
+        _echart_vbar_pointer_update(sd);
+        echart_stats_mark(&sd->common.stats, ECHART_STATS_STAGE_HOVER);
+    }
+
+    echart_stats_frame_end(&sd->common.stats);
 }
 
 static void
@@ -577,7 +1209,7 @@ echart_vbar_object_chart_set(Evas_Object *obj, const Echart_Chart *chart)
     INF("chart set");
 
     sd->common.chart = chart;
-    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
 }
 
 EAPI void
@@ -592,5 +1224,76 @@ echart_vbar_object_group_width_set(Evas_Object *obj, double group_width)
         return;
 
     sd->group_width = group_width;
-    evas_object_smart_need_recalculate_set(obj, EINA_TRUE);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_vbar_object_viewport_set(Evas_Object *obj,
+                                double xmin, double xmax,
+                                double ymin, double ymax)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_VBAR_SMART_OBJ_GET(sd, obj, ECHART_VBAR_OBJ_NAME);
+
+    echart_viewport_set((Echart_Smart_Common *)sd, xmin, xmax, ymin, ymax);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_vbar_object_viewport_get(const Evas_Object *obj,
+                                double *xmin, double *xmax,
+                                double *ymin, double *ymax)
+{
+    Echart_Smart_Data *sd;
+    double x0 = 0;
+    double x1 = 0;
+    double y0 = 0;
+    double y1 = 0;
+
+    if (xmin) *xmin = 0;
+    if (xmax) *xmax = 0;
+    if (ymin) *ymin = 0;
+    if (ymax) *ymax = 0;
+
+    ECHART_VBAR_SMART_OBJ_GET(sd, obj, ECHART_VBAR_OBJ_NAME);
+
+    echart_viewport_get((Echart_Smart_Common *)sd, &x0, &x1, &y0, &y1);
+    if (xmin) *xmin = x0;
+    if (xmax) *xmax = x1;
+    if (ymin) *ymin = y0;
+    if (ymax) *ymax = y1;
+}
+
+EAPI void
+echart_vbar_object_viewport_reset(Evas_Object *obj)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_VBAR_SMART_OBJ_GET(sd, obj, ECHART_VBAR_OBJ_NAME);
+
+    echart_viewport_reset((Echart_Smart_Common *)sd);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_vbar_object_pan(Evas_Object *obj, double dx, double dy)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_VBAR_SMART_OBJ_GET(sd, obj, ECHART_VBAR_OBJ_NAME);
+
+    echart_viewport_pan((Echart_Smart_Common *)sd, dx, dy);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
+}
+
+EAPI void
+echart_vbar_object_zoom(Evas_Object *obj, double factor, double x, double y)
+{
+    Echart_Smart_Data *sd;
+
+    ECHART_VBAR_SMART_OBJ_GET(sd, obj, ECHART_VBAR_OBJ_NAME);
+
+    echart_viewport_zoom((Echart_Smart_Common *)sd, factor, x, y);
+    echart_object_changed((Echart_Smart_Common *)sd, obj, EINA_TRUE);
 }
@@ -23,4 +23,14 @@ EAPI Evas_Object *echart_vbar_object_add(Evas *evas);
 EAPI void echart_vbar_object_chart_set(Evas_Object *obj, const Echart_Chart *chart);
 EAPI void echart_vbar_object_group_width_set(Evas_Object *obj, double group_width);
 
+EAPI void echart_vbar_object_viewport_set(Evas_Object *obj,
+                                          double xmin, double xmax,
+                                          double ymin, double ymax);
+EAPI void echart_vbar_object_viewport_get(const Evas_Object *obj,
+                                          double *xmin, double *xmax,
+                                          double *ymin, double *ymax);
+EAPI void echart_vbar_object_viewport_reset(Evas_Object *obj);
+EAPI void echart_vbar_object_pan(Evas_Object *obj, double dx, double dy);
+EAPI void echart_vbar_object_zoom(Evas_Object *obj, double factor, double x, double y);
+
 #endif /* ECHART_VBAR_H */
@@ -0,0 +1,721 @@
+/* Echart - Chart rendering library
+ * Copyright (C) 2017 Vincent Torri
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EFL_BETA_API_SUPPORT
+#define EFL_BETA_API_SUPPORT 1
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <Eina.h>
+#include <Evas.h>
+
+#include <Echart.h>
+#include <echart_data.h>
+#include <echart_chart.h>
+#include <echart_line.h>
+#include <echart_lod.h>
+#include <echart_scale.h>
+#include <echart_histogram.h>
+#include <echart_ohlc.h>
+
+/*
+ * Unit tests of the calculations that do not need a canvas: the ticks
+ * of the axes, the level of detail reductions, the choice of the bins
+ * of the histograms and the aggregation of the candles.
+ */
+
+static unsigned int _echart_test_count = 0;
+static unsigned int _echart_test_failures = 0;
+
+static void
+_echart_test_check(Eina_Bool ok, const char *expr, const char *func, int line)
+{
+    _echart_test_count++;
+    if (ok)
+        return;
+
+    _echart_test_failures++;
+    fprintf(stderr, "%s:%d: check failed: %s\n", func, line, expr);
+}
+
+#define ECHART_TEST_CHECK(expr) \
+    _echart_test_check(!!(expr), #expr, __FUNCTION__, __LINE__)
+
+static Eina_Bool
+_echart_test_eq(double a, double b)
+{
+    return fabs(a - b) <= 1e-9 * (1 + fabs(b));
+}
+
+static Eina_Bool
+_echart_test_label_eq(const Echart_Scale *s, unsigned int i, const char *label)
+{
+    char buf[32];
+
+    echart_scale_label_get(s, i, buf, sizeof(buf));
+
+    return !strcmp(buf, label);
+}
+
+static Eina_Bool
+_echart_test_format_eq(double v, int decimals, const char *label)
+{
+    char buf[32];
+    size_t len;
+
+    len = echart_scale_format(v, decimals, buf, sizeof(buf));
+
+    return (len == strlen(label)) && !strcmp(buf, label);
+}
+
+/*
+ * Properties of the ticks of any range: nbr intervals step apart,
+ * around the range, starting at a multiple of the step if they are
+ * nice, with the decimals of the step.
+ */
+static void
+_echart_test_scale_check(double min, double max, int nbr, int length,
+                         Eina_Bool fixed, unsigned int expected)
+{
+    Echart_Scale s;
+    double q;
+    Eina_Bool empty;
+
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, min, max, nbr, length, fixed);
+
+    /* an empty range is widened */
+    empty = !(max > min);
+    if (empty)
+        max = min;
+
+    ECHART_TEST_CHECK(s.nbr == expected);
+    ECHART_TEST_CHECK(s.step > 0);
+    ECHART_TEST_CHECK(s.max > s.min);
+    ECHART_TEST_CHECK(s.min <= min);
+    ECHART_TEST_CHECK(s.max >= max);
+    ECHART_TEST_CHECK(_echart_test_eq(s.min + s.nbr * s.step, s.max));
+    ECHART_TEST_CHECK(_echart_test_eq(echart_scale_tick_get(&s, 0), s.min));
+    ECHART_TEST_CHECK(echart_scale_tick_get(&s, s.nbr) == s.max);
+    ECHART_TEST_CHECK(s.decimals == echart_scale_decimals_get(s.step));
+    if (fixed)
+    {
+        ECHART_TEST_CHECK(s.min == min);
+        ECHART_TEST_CHECK(empty || (s.max == max));
+    }
+    else
+    {
+        q = s.min / s.step;
+        ECHART_TEST_CHECK(fabs(q - floor(q + 0.5)) < 1e-6);
+        /* the next smaller step would not reach max */
+        ECHART_TEST_CHECK(empty || (s.min + (s.nbr - 1) * s.step < max));
+    }
+}
+
+static void
+_echart_test_scale(void)
+{
+    Echart_Scale s;
+
+    ECHART_TEST_CHECK(echart_scale_decimals_get(0) == 0);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(-0.0) == 0);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(1) == 0);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(20) == 0);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(0.5) == 1);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(-0.25) == 2);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(0.001) == 3);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(-0.001) == 3);
+    ECHART_TEST_CHECK(echart_scale_decimals_get(1e-12) == 9);
+
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, 0, 100, 5, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.nbr == 5);
+    ECHART_TEST_CHECK(s.min == 0);
+    ECHART_TEST_CHECK(s.max == 100);
+    ECHART_TEST_CHECK(s.step == 20);
+    ECHART_TEST_CHECK(s.decimals == 0);
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 1, "20"));
+
+    /* a cache: the same key keeps the ticks, another one changes them */
+    s.step = 0;
+    echart_scale_set(&s, 0, 100, 5, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.step == 0);
+    echart_scale_set(&s, 0, 100, 4, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.step == 25);
+
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, -7, -2, 5, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.min == -7);
+    ECHART_TEST_CHECK(s.max == -2);
+    ECHART_TEST_CHECK(s.step == 1);
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 0, "-7"));
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 5, "-2"));
+
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, 0, 10, 4, 0, EINA_TRUE);
+    ECHART_TEST_CHECK(s.step == 2.5);
+    ECHART_TEST_CHECK(s.decimals == 1);
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 1, "2.5"));
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 4, "10.0"));
+
+    _echart_test_scale_check(0, 100, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(-7, -2, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(-1234.5, 987.25, 7, 0, EINA_FALSE, 7);
+    _echart_test_scale_check(-0.003, -0.001, 4, 0, EINA_FALSE, 4);
+    _echart_test_scale_check(1e6, 1e6 + 3, 3, 0, EINA_FALSE, 3);
+    _echart_test_scale_check(0, 10, 4, 0, EINA_TRUE, 4);
+    _echart_test_scale_check(-10, -5, 3, 0, EINA_TRUE, 3);
+    /* the number of ticks from the length */
+    _echart_test_scale_check(0, 100, 0, 480, EINA_FALSE, 10);
+    _echart_test_scale_check(0, 100, 0, 10, EINA_FALSE, 1);
+    _echart_test_scale_check(0, 100, -1, 0, EINA_FALSE, 1);
+    /* degenerate ranges */
+    _echart_test_scale_check(0, 0, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(3, 3, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(-3, -3, 4, 0, EINA_FALSE, 4);
+    _echart_test_scale_check(5, 1, 4, 0, EINA_FALSE, 4);
+    _echart_test_scale_check(0, 0, 2, 0, EINA_TRUE, 2);
+    /* empty ranges below the precision of 1 */
+    _echart_test_scale_check(2e16, 2e16, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(1e17, 1e17, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(-1e17, -1e17, 5, 0, EINA_FALSE, 5);
+    _echart_test_scale_check(1e300, 1e300, 3, 0, EINA_FALSE, 3);
+    _echart_test_scale_check(1e17, 1e17 + 16, 4, 0, EINA_FALSE, 4);
+    _echart_test_scale_check(1e-320, 2e-320, 5, 0, EINA_FALSE, 5);
+}
+
+/* NaN and infinite bounds give the fixed range [0, 1] */
+static void
+_echart_test_scale_not_finite_check(double min, double max)
+{
+    Echart_Scale s;
+
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, min, max, 4, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.nbr == 4);
+    ECHART_TEST_CHECK(s.min == 0);
+    ECHART_TEST_CHECK(s.max == 1);
+    ECHART_TEST_CHECK(s.step == 0.25);
+    ECHART_TEST_CHECK(_echart_test_label_eq(&s, 1, "0.25"));
+}
+
+static void
+_echart_test_scale_not_finite(void)
+{
+    Echart_Scale s;
+
+    _echart_test_scale_not_finite_check(NAN, 3);
+    _echart_test_scale_not_finite_check(0, NAN);
+    _echart_test_scale_not_finite_check(NAN, NAN);
+    _echart_test_scale_not_finite_check(0, INFINITY);
+    _echart_test_scale_not_finite_check(-INFINITY, 0);
+    _echart_test_scale_not_finite_check(-INFINITY, INFINITY);
+
+    /* finite bounds, but a width that overflows */
+    memset(&s, 0, sizeof(s));
+    echart_scale_set(&s, -1e308, 1e308, 4, 0, EINA_FALSE);
+    ECHART_TEST_CHECK(s.nbr == 4);
+    ECHART_TEST_CHECK(s.min == -1e308);
+    ECHART_TEST_CHECK(s.max == 1e308);
+    ECHART_TEST_CHECK(isfinite(s.step) && (s.step > 0));
+    ECHART_TEST_CHECK(isfinite(echart_scale_tick_get(&s, 2)));
+}
+
+static void
+_echart_test_format(void)
+{
+    char buf[8];
+
+    ECHART_TEST_CHECK(_echart_test_format_eq(0, 0, "0"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(-0.0, 0, "0"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(0, 2, "0.00"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(7, 0, "7"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(-1.5, 1, "-1.5"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(0.25, 2, "0.25"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(-0.25, 2, "-0.25"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(1234.5678, 2, "1234.57"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(-1234.5, 0, "-1235"));
+    /* no minus sign when it is rounded to 0 */
+    ECHART_TEST_CHECK(_echart_test_format_eq(-0.04, 1, "0.0"));
+    /* the decimals are clamped */
+    ECHART_TEST_CHECK(_echart_test_format_eq(2.4, -1, "2"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(1, 12, "1.000000000"));
+    /* out of the range of the integers */
+    ECHART_TEST_CHECK(_echart_test_format_eq(1e20, 0, "1e+20"));
+    ECHART_TEST_CHECK(_echart_test_format_eq(-1e20, 0, "-1e+20"));
+
+    /* truncated to the size of the buffer */
+    ECHART_TEST_CHECK(echart_scale_format(12345, 0, buf, 4) == 3);
+    ECHART_TEST_CHECK(!strcmp(buf, "123"));
+    ECHART_TEST_CHECK(echart_scale_format(12345, 0, buf, 0) == 0);
+}
+
+static void
+_echart_test_lod_downsample(void)
+{
+    double xv[100];
+    double yv[100];
+    double xo[100];
+    double yo[100];
+    unsigned int n;
+    unsigned int i;
+    Eina_Bool spike;
+    Eina_Bool sorted;
+    Eina_Bool samples;
+
+    for (i = 0; i < 100; i++)
+    {
+        xv[i] = i;
+        yv[i] = -sin(i * 0.3) * i;
+    }
+    yv[50] = 1000;
+
+    n = echart_lod_downsample(xv, yv, 0, 99, 10, xo, yo);
+    ECHART_TEST_CHECK(n == 10);
+    ECHART_TEST_CHECK(xo[0] == 0);
+    ECHART_TEST_CHECK(xo[n - 1] == 99);
+    spike = EINA_FALSE;
+    sorted = EINA_TRUE;
+    samples = EINA_TRUE;
+    for (i = 0; i < n; i++)
+    {
+        if ((i > 0) && !(xo[i] > xo[i - 1]))
+            sorted = EINA_FALSE;
+        if (yo[i] != yv[(unsigned int)xo[i]])
+            samples = EINA_FALSE;
+        if (yo[i] == 1000)
+            spike = EINA_TRUE;
+    }
+    ECHART_TEST_CHECK(sorted);
+    ECHART_TEST_CHECK(samples);
+    ECHART_TEST_CHECK(spike);
+
+    /* a part of the samples */
+    n = echart_lod_downsample(xv, yv, 10, 59, 10, xo, yo);
+    ECHART_TEST_CHECK(n == 10);
+    ECHART_TEST_CHECK(xo[0] == 10);
+    ECHART_TEST_CHECK(xo[n - 1] == 59);
+
+    /* too few samples or a too small threshold: all the samples */
+    n = echart_lod_downsample(xv, yv, 0, 9, 10, xo, yo);
+    ECHART_TEST_CHECK(n == 10);
+    ECHART_TEST_CHECK((xo[3] == 3) && (yo[3] == yv[3]));
+    n = echart_lod_downsample(xv, yv, 0, 99, 2, xo, yo);
+    ECHART_TEST_CHECK(n == 100);
+
+    /* degenerate ranges */
+    n = echart_lod_downsample(xv, yv, 42, 42, 10, xo, yo);
+    ECHART_TEST_CHECK(n == 1);
+    ECHART_TEST_CHECK((xo[0] == 42) && (yo[0] == yv[42]));
+    n = echart_lod_downsample(xv, yv, 43, 42, 10, xo, yo);
+    ECHART_TEST_CHECK(n == 0);
+}
+
+/*
+ * The envelope keeps the order of the samples, and the same minimum and
+ * maximum in each column as the samples.
+ */
+static void
+_echart_test_envelope_check(const double *xv, const double *yv,
+                            unsigned int nbr,
+                            double xmin, double xmax, unsigned int columns)
+{
+    double xo[4 * (16 + 2)];
+    double yo[4 * (16 + 2)];
+    double scale;
+    unsigned int n;
+    unsigned int i;
+    long col;
+    long c;
+    Eina_Bool sorted;
+    Eina_Bool extrema;
+
+    n = echart_lod_envelope(xv, yv, 0, nbr - 1, xmin, xmax, columns, xo, yo);
+    ECHART_TEST_CHECK(n >= 1);
+    ECHART_TEST_CHECK(n <= 4 * (columns + 2));
+    ECHART_TEST_CHECK((xo[0] == xv[0]) && (yo[0] == yv[0]));
+    ECHART_TEST_CHECK((xo[n - 1] == xv[nbr - 1]) && (yo[n - 1] == yv[nbr - 1]));
+
+    sorted = EINA_TRUE;
+    for (i = 1; i < n; i++)
+    {
+        if (xo[i] < xo[i - 1])
+            sorted = EINA_FALSE;
+    }
+    ECHART_TEST_CHECK(sorted);
+
+    scale = (xmax > xmin) ? columns / (xmax - xmin) : 0;
+    extrema = EINA_TRUE;
+    for (col = -1; col <= (long)columns; col++)
+    {
+        double min_in = HUGE_VAL;
+        double max_in = -HUGE_VAL;
+        double min_out = HUGE_VAL;
+        double max_out = -HUGE_VAL;
+
+        for (i = 0; i < nbr; i++)
+        {
+            c = (long)floor((xv[i] - xmin) * scale);
+            if (c < 0) c = -1;
+            if (c > (long)columns) c = columns;
+            if (c != col)
+                continue;
+            if (yv[i] < min_in) min_in = yv[i];
+            if (yv[i] > max_in) max_in = yv[i];
+        }
+        for (i = 0; i < n; i++)
+        {
+            c = (long)floor((xo[i] - xmin) * scale);
+            if (c < 0) c = -1;
+            if (c > (long)columns) c = columns;
+            if (c != col)
+                continue;
+            if (yo[i] < min_out) min_out = yo[i];
+            if (yo[i] > max_out) max_out = yo[i];
+        }
+        if ((min_in != min_out) || (max_in != max_out))
+            extrema = EINA_FALSE;
+    }
+    ECHART_TEST_CHECK(extrema);
+}
+
+static void
+_echart_test_lod_envelope(void)
+{
+    double xv[200];
+    double yv[200];
+    double xo[8];
+    double yo[8];
+    unsigned int i;
+
+    for (i = 0; i < 200; i++)
+    {
+        xv[i] = i * 0.5;
+        yv[i] = sin(i * 0.7) * i;
+    }
+
+    _echart_test_envelope_check(xv, yv, 200, 0, 100, 16);
+    _echart_test_envelope_check(xv, yv, 200, 0, 100, 1);
+    /* samples out of the window, on both sides */
+    _echart_test_envelope_check(xv, yv, 200, 20, 60, 16);
+
+    /* negative absciss */
+    for (i = 0; i < 200; i++)
+        xv[i] = -100 + i * 0.5;
+    _echart_test_envelope_check(xv, yv, 200, -100, 0, 16);
+    _echart_test_envelope_check(xv, yv, 200, -80, -40, 10);
+
+    /* degenerate ranges: all the samples in a single column */
+    _echart_test_envelope_check(xv, yv, 200, -50, -50, 16);
+    _echart_test_envelope_check(xv, yv, 200, 0, -10, 16);
+    _echart_test_envelope_check(xv, yv, 1, -100, 0, 16);
+    ECHART_TEST_CHECK(echart_lod_envelope(xv, yv, 5, 4, -100, 0, 16, xo, yo) == 0);
+}
+
+static Echart_Serie *
+_echart_test_serie_new(double first, double step, unsigned int nbr)
+{
+    Echart_Serie *s;
+    unsigned int i;
+
+    s = echart_serie_new();
+    for (i = 0; i < nbr; i++)
+        echart_serie_value_push(s, first + i * step);
+
+    return s;
+}
+
+static unsigned int
+_echart_test_counts_sum(const unsigned int *counts, unsigned int nbr)
+{
+    unsigned int sum;
+    unsigned int i;
+
+    sum = 0;
+    for (i = 0; i < nbr; i++)
+        sum += counts[i];
+
+    return sum;
+}
+
+static void
+_echart_test_histogram(void)
+{
+    Echart_Histogram *h;
+    Echart_Serie *s;
+    const unsigned int *counts;
+    unsigned int nbr;
+    double min;
+    double width;
+    unsigned int i;
+
+    /*
+     * Freedman-Diaconis: the quartiles of 1000 uniform samples over
+     * [0, 999] are 500 apart, so the bins are 2 * 500 / 10 = 100 wide.
+     */
+    s = _echart_test_serie_new(0, 1, 1000);
+    h = echart_histogram_new(s);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(counts != NULL);
+    ECHART_TEST_CHECK(nbr == 10);
+    ECHART_TEST_CHECK(min == 0);
+    ECHART_TEST_CHECK(_echart_test_eq(width, 99.9));
+    ECHART_TEST_CHECK(_echart_test_counts_sum(counts, nbr) == 1000);
+
+    /* the samples are counted again when they are appended */
+    for (i = 0; i < 1000; i++)
+        echart_serie_value_push(s, 999 - i);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(_echart_test_counts_sum(counts, nbr) == 2000);
+
+    /* an empty range is ignored */
+    echart_histogram_range_set(h, 1, 1);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(min == 0);
+    ECHART_TEST_CHECK(_echart_test_eq(width * nbr, 999));
+
+    /* too many bins: their number is capped, the range is kept */
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_WIDTH, 1e-6);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 65536);
+    ECHART_TEST_CHECK(min == 0);
+    ECHART_TEST_CHECK(_echart_test_eq(width, 999.0 / 65536));
+    ECHART_TEST_CHECK(_echart_test_counts_sum(counts, nbr) == 2000);
+
+    /* a width or a number of bins that is not positive is ignored */
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_WIDTH, 0);
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_COUNT, -3);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 65536);
+
+    echart_histogram_free(h);
+    echart_serie_free(s);
+
+    /* negative samples */
+    s = _echart_test_serie_new(-10, 1, 10);
+    h = echart_histogram_new(s);
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_WIDTH, 1);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 9);
+    ECHART_TEST_CHECK(min == -10);
+    ECHART_TEST_CHECK(width == 1);
+    /* the maximum is in the last bin */
+    ECHART_TEST_CHECK(counts[nbr - 1] == 2);
+    ECHART_TEST_CHECK(_echart_test_counts_sum(counts, nbr) == 10);
+
+    /* samples around 0 */
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_COUNT, 4.5);
+    echart_histogram_range_set(h, -2, 2);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 4);
+    ECHART_TEST_CHECK(min == -2);
+    ECHART_TEST_CHECK(width == 1);
+    ECHART_TEST_CHECK(_echart_test_counts_sum(counts, nbr) == 2);
+    echart_histogram_free(h);
+    echart_serie_free(s);
+
+    /* a single value, in the middle of a bin of width 1 */
+    s = _echart_test_serie_new(3, 0, 5);
+    h = echart_histogram_new(s);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 1);
+    ECHART_TEST_CHECK(min == 2.5);
+    ECHART_TEST_CHECK(width == 1);
+    ECHART_TEST_CHECK(counts[0] == 5);
+    echart_histogram_bins_set(h, ECHART_HISTOGRAM_BINS_WIDTH, 0.1);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(nbr == 1);
+    ECHART_TEST_CHECK(counts[0] == 5);
+    echart_histogram_free(h);
+    echart_serie_free(s);
+
+    /* no samples */
+    s = echart_serie_new();
+    h = echart_histogram_new(s);
+    counts = echart_histogram_counts_get(h, &nbr, &min, &width);
+    ECHART_TEST_CHECK(counts == NULL);
+    ECHART_TEST_CHECK(nbr == 0);
+    echart_histogram_free(h);
+    echart_serie_free(s);
+
+    ECHART_TEST_CHECK(echart_histogram_new(NULL) == NULL);
+}
+
+static void
+_echart_test_stacked(void)
+{
+    Echart_Data *d;
+    Echart_Serie *x;
+    Echart_Serie *a;
+    Echart_Serie *b;
+    double ymin;
+    double ymax;
+    unsigned int i;
+
+    x = _echart_test_serie_new(0, 1, 4);
+    a = _echart_test_serie_new(1, 1, 4);
+    b = _echart_test_serie_new(1, 0, 4);
+    d = echart_data_new();
+    echart_data_absciss_set(d, x);
+    echart_data_serie_append(d, a);
+    echart_data_serie_append(d, b);
+    echart_data_stacked_set(d, EINA_TRUE);
+
+    /* the stacks start at 0 */
+    echart_data_interval_get(d, &ymin, &ymax);
+    ECHART_TEST_CHECK(ymin == 0);
+    ECHART_TEST_CHECK(ymax == 5);
+
+    /* only the samples that all the series have are stacked */
+    echart_serie_value_push(x, 4);
+    echart_serie_value_push(a, 10);
+    echart_data_interval_get(d, &ymin, &ymax);
+    ECHART_TEST_CHECK(ymax == 5);
+    /* each layer of the stacks is in the interval */
+    echart_serie_value_push(b, -30);
+    echart_data_interval_get(d, &ymin, &ymax);
+    ECHART_TEST_CHECK(ymin == -20);
+    ECHART_TEST_CHECK(ymax == 10);
+
+    /* more samples than the sums of the previous update */
+    for (i = 0; i < 8; i++)
+    {
+        echart_serie_value_push(x, 5 + i);
+        echart_serie_value_push(a, 20);
+        echart_serie_value_push(b, i);
+    }
+    echart_data_interval_get(d, &ymin, &ymax);
+    ECHART_TEST_CHECK(ymin == -20);
+    ECHART_TEST_CHECK(ymax == 27);
+
+    echart_data_free(d);
+}
+
+static Eina_Bool
+_echart_test_candle_eq(const Echart_Ohlc_Candle *c,
+                       double t, double open, double high,
+                       double low, double close)
+{
+    return (c->t == t) && (c->open == open) && (c->high == high) &&
+        (c->low == low) && (c->close == close);
+}
+
+static void
+_echart_test_ohlc(void)
+{
+    Echart_Ohlc *o;
+    Echart_Serie *ts;
+    Echart_Serie *ps;
+    const Echart_Ohlc_Candle *c;
+    unsigned int nbr;
+
+    ECHART_TEST_CHECK(echart_ohlc_new(0) == NULL);
+    ECHART_TEST_CHECK(echart_ohlc_new(-60) == NULL);
+
+    o = echart_ohlc_new(60);
+    ECHART_TEST_CHECK(echart_ohlc_interval_get(o) == 60);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK((c == NULL) && (nbr == 0));
+
+    echart_ohlc_tick_push(o, 0, 10);
+    echart_ohlc_tick_push(o, 30, 12);
+    echart_ohlc_tick_push(o, 59, 8);
+    /* the start of an interval begins a candle */
+    echart_ohlc_tick_push(o, 60, 9);
+    /* an interval without tick has no candle */
+    echart_ohlc_tick_push(o, 150, 11);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK(nbr == 3);
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 0, 0, 10, 12, 8, 8));
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 1, 60, 9, 9, 9, 9));
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 2, 120, 11, 11, 11, 11));
+
+    /* a late tick only widens the last candle */
+    echart_ohlc_tick_push(o, 100, 20);
+    echart_ohlc_tick_push(o, 10, -5);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK(nbr == 3);
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 2, 120, 11, 20, -5, 11));
+
+    echart_ohlc_reset(o);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK((c == NULL) && (nbr == 0));
+    echart_ohlc_free(o);
+
+    /* negative timestamps and prices */
+    o = echart_ohlc_new(1);
+    echart_ohlc_tick_push(o, -0.5, -3);
+    echart_ohlc_tick_push(o, -0.25, -1);
+    echart_ohlc_tick_push(o, -0.1, -2);
+    echart_ohlc_tick_push(o, 0, 0);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK(nbr == 2);
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 0, -1, -3, -1, -3, -2));
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 1, 0, 0, 0, 0, 0));
+    echart_ohlc_free(o);
+
+    /* the series: only the appended ticks are pushed */
+    ts = _echart_test_serie_new(0, 20, 4);
+    ps = _echart_test_serie_new(1, 1, 4);
+    o = echart_ohlc_new(60);
+    echart_ohlc_series_update(o, ts, ps);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK(nbr == 2);
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 0, 0, 1, 3, 1, 3));
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 1, 60, 4, 4, 4, 4));
+    echart_serie_value_push(ts, 80);
+    echart_serie_value_push(ps, 0.5);
+    echart_ohlc_series_update(o, ts, ps);
+    echart_ohlc_series_update(o, ts, ps);
+    c = echart_ohlc_candles_get(o, &nbr);
+    ECHART_TEST_CHECK(nbr == 2);
+    ECHART_TEST_CHECK(_echart_test_candle_eq(c + 1, 60, 4, 4, 0.5, 0.5));
+    echart_ohlc_free(o);
+    echart_serie_free(ts);
+    echart_serie_free(ps);
+}
+
+int
+main(void)
+{
+    if (!echart_init())
+    {
+        fprintf(stderr, "Could not initialize Echart.\n");
+        return EXIT_FAILURE;
+    }
+
+    _echart_test_scale();
+    _echart_test_scale_not_finite();
+    _echart_test_format();
+    _echart_test_lod_downsample();
+    _echart_test_lod_envelope();
+    _echart_test_histogram();
+    _echart_test_stacked();
+    _echart_test_ohlc();
+
+    echart_shutdown();
+
+    printf("%u checks, %u failures\n",
+           _echart_test_count, _echart_test_failures);
+
+    return _echart_test_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}